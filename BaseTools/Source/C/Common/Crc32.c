@@ -274,6 +274,50 @@ UINT32  mCrcTable[256] = {
   0x2D02EF8D
 };
 
+//
+// Slicing-by-8 tables, built from mCrcTable on first use. mCrcSliceTable[N - 1][Byte]
+// is the CRC of Byte followed by N zero bytes, so eight input bytes can be folded
+// into the CRC with eight independent lookups.
+//
+STATIC UINT32   mCrcSliceTable[7][256];
+STATIC BOOLEAN  mCrcSliceTableReady = FALSE;
+
+STATIC
+VOID
+InitializeCrcSliceTable (
+  VOID
+  )
+/*++
+
+Routine Description:
+
+  Build the slicing-by-8 tables from mCrcTable.
+
+Arguments:
+
+  None
+
+Returns:
+
+  None
+
+--*/
+{
+  UINTN   TableEntry;
+  UINTN   Index;
+  UINT32  Value;
+
+  for (TableEntry = 0; TableEntry < 256; TableEntry++) {
+    Value = mCrcTable[TableEntry];
+    for (Index = 0; Index < 7; Index++) {
+      Value = (Value >> 8) ^ mCrcTable[(UINT8) Value];
+      mCrcSliceTable[Index][TableEntry] = Value;
+    }
+  }
+
+  mCrcSliceTableReady = TRUE;
+}
+
 EFI_STATUS
 CalculateCrc32 (
   IN  UINT8                             *Data,
@@ -301,16 +345,40 @@ Returns:
 --*/
 {
   UINT32  Crc;
-  UINTN   Index;
+  UINT32  Low;
+  UINT32  High;
   UINT8   *Ptr;
 
   if ((DataSize == 0) || (Data == NULL) || (CrcOut == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
 
+  if (!mCrcSliceTableReady) {
+    InitializeCrcSliceTable ();
+  }
+
   Crc = 0xffffffff;
-  for (Index = 0, Ptr = Data; Index < DataSize; Index++, Ptr++) {
+  Ptr = Data;
+
+  //
+  // Process 8 bytes per iteration. The words are assembled byte by byte so that
+  // the result does not depend on the alignment or the endianness of the host.
+  //
+  while (DataSize >= 8) {
+    Low  = Crc ^ (Ptr[0] | ((UINT32) Ptr[1] << 8) | ((UINT32) Ptr[2] << 16) | ((UINT32) Ptr[3] << 24));
+    High = Ptr[4] | ((UINT32) Ptr[5] << 8) | ((UINT32) Ptr[6] << 16) | ((UINT32) Ptr[7] << 24);
+    Crc  = mCrcSliceTable[6][(UINT8) Low]         ^ mCrcSliceTable[5][(UINT8) (Low >> 8)]  ^
+           mCrcSliceTable[4][(UINT8) (Low >> 16)] ^ mCrcSliceTable[3][(UINT8) (Low >> 24)] ^
+           mCrcSliceTable[2][(UINT8) High]        ^ mCrcSliceTable[1][(UINT8) (High >> 8)] ^
+           mCrcSliceTable[0][(UINT8) (High >> 16)] ^ mCrcTable[(UINT8) (High >> 24)];
+    Ptr      += 8;
+    DataSize -= 8;
+  }
+
+  while (DataSize > 0) {
     Crc = (Crc >> 8) ^ mCrcTable[(UINT8) Crc ^ *Ptr];
+    Ptr++;
+    DataSize--;
   }
 
   *CrcOut = Crc ^ 0xffffffff;
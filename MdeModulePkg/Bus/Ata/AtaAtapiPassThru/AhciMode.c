@@ -548,7 +548,15 @@ AhciBuildCommand (
 
   ZeroMem ((VOID *)((UINTN) BaseAddr), sizeof (EFI_AHCI_RECEIVED_FIS));
 
-  ZeroMem (AhciRegisters->AhciCommandTable, sizeof (EFI_AHCI_COMMAND_TABLE));
+  //
+  // The command table has room for 65535 PRDT entries, about 1MB, while the
+  // controller only reads the PrdtNumber entries given in the command list.
+  // Clear just that part, instead of the whole table for every command.
+  //
+  ZeroMem (
+    AhciRegisters->AhciCommandTable,
+    OFFSET_OF (EFI_AHCI_COMMAND_TABLE, PrdtTable) + PrdtNumber * sizeof (EFI_AHCI_COMMAND_PRDT)
+    );
 
   CommandFis->AhciCFisPmNum = PortMultiplier;
 
@@ -39,7 +39,7 @@ EFI_DRIVER_SUPPORTED_EFI_VERSION_PROTOCOL gNvmExpressDriverSupportedEfiVersion =
 // Template for NVM Express Pass Thru Mode data structure.
 //
 GLOBAL_REMOVE_IF_UNREFERENCED EFI_NVM_EXPRESS_PASS_THRU_MODE gEfiNvmExpressPassThruMode = {
-  EFI_NVM_EXPRESS_PASS_THRU_ATTRIBUTES_PHYSICAL | EFI_NVM_EXPRESS_PASS_THRU_ATTRIBUTES_LOGICAL | EFI_NVM_EXPRESS_PASS_THRU_ATTRIBUTES_CMD_SET_NVM,
+  EFI_NVM_EXPRESS_PASS_THRU_ATTRIBUTES_PHYSICAL | EFI_NVM_EXPRESS_PASS_THRU_ATTRIBUTES_LOGICAL | EFI_NVM_EXPRESS_PASS_THRU_ATTRIBUTES_NONBLOCKIO | EFI_NVM_EXPRESS_PASS_THRU_ATTRIBUTES_CMD_SET_NVM,
   sizeof (UINTN),
   0x10100
 };
@@ -154,6 +154,16 @@ EnumerateNvmeDevNamespace (
     Device->BlockIo.WriteBlocks  = NvmeBlockIoWriteBlocks;
     Device->BlockIo.FlushBlocks  = NvmeBlockIoFlushBlocks;
 
+    //
+    // Create BlockIo2 Protocol instance
+    //
+    Device->BlockIo2.Media          = &Device->Media;
+    Device->BlockIo2.Reset          = NvmeBlockIoResetEx;
+    Device->BlockIo2.ReadBlocksEx   = NvmeBlockIoReadBlocksEx;
+    Device->BlockIo2.WriteBlocksEx  = NvmeBlockIoWriteBlocksEx;
+    Device->BlockIo2.FlushBlocksEx  = NvmeBlockIoFlushBlocksEx;
+    InitializeListHead (&Device->AsyncQueue);
+
     //
     // Create StorageSecurityProtocol Instance
     //
@@ -209,6 +219,8 @@ EnumerateNvmeDevNamespace (
                     Device->DevicePath,
                     &gEfiBlockIoProtocolGuid,
                     &Device->BlockIo,
+                    &gEfiBlockIo2ProtocolGuid,
+                    &Device->BlockIo2,
                     &gEfiDiskInfoProtocolGuid,
                     &Device->DiskInfo,
                     NULL
@@ -235,6 +247,8 @@ EnumerateNvmeDevNamespace (
                Device->DevicePath,
                &gEfiBlockIoProtocolGuid,
                &Device->BlockIo,
+               &gEfiBlockIo2ProtocolGuid,
+               &Device->BlockIo2,
                &gEfiDiskInfoProtocolGuid,
                &Device->DiskInfo,
                NULL
@@ -357,6 +371,8 @@ DiscoverAllNamespaces (
   @param  Handle                The child handle.
 
   @retval EFI_SUCCESS           The namespace is successfully unregistered.
+  @retval EFI_DEVICE_ERROR      The non-blocking requests of the namespace are not
+                                completed, the namespace is left registered.
   @return Others                Some error occurs when unregistering the namespace.
 
 **/
@@ -390,6 +406,15 @@ UnregisterNvmeNamespace (
   Device  = NVME_DEVICE_PRIVATE_DATA_FROM_BLOCK_IO (BlockIo);
   Private = Device->Controller;
 
+  //
+  // Wait for the device's asynchronous I/O queue to become empty. The requests
+  // still queued reference the device data.
+  //
+  Status = NvmeWaitAsyncQueueEmpty (Private, Device);
+  if (EFI_ERROR (Status)) {
+    return EFI_DEVICE_ERROR;
+  }
+
   //
   // Close the child handle
   //
@@ -401,8 +426,8 @@ UnregisterNvmeNamespace (
          );
 
   //
-  // The Nvm Express driver installs the BlockIo and DiskInfo in the DriverBindingStart().
-  // Here should uninstall both of them.
+  // The Nvm Express driver installs the BlockIo, BlockIo2 and DiskInfo in the DriverBindingStart().
+  // Here should uninstall all of them.
   //
   Status = gBS->UninstallMultipleProtocolInterfaces (
                   Handle,
@@ -410,6 +435,8 @@ UnregisterNvmeNamespace (
                   Device->DevicePath,
                   &gEfiBlockIoProtocolGuid,
                   &Device->BlockIo,
+                  &gEfiBlockIo2ProtocolGuid,
+                  &Device->BlockIo2,
                   &gEfiDiskInfoProtocolGuid,
                   &Device->DiskInfo,
                   NULL
@@ -471,6 +498,207 @@ UnregisterNvmeNamespace (
   return EFI_SUCCESS;
 }
 
+/**
+  Free the resources of a non-blocking command and signal its caller.
+
+  @param[in]  PciIo          The PCI IO protocol instance.
+  @param[in]  AsyncRequest   The non-blocking command, whose completion has
+                             been put in the caller's packet.
+
+**/
+VOID
+NvmeCompleteAsyncRequest (
+  IN EFI_PCI_IO_PROTOCOL          *PciIo,
+  IN NVME_PASS_THRU_ASYNC_REQ     *AsyncRequest
+  )
+{
+  if (AsyncRequest->MapData != NULL) {
+    PciIo->Unmap (PciIo, AsyncRequest->MapData);
+  }
+  if (AsyncRequest->MapMeta != NULL) {
+    PciIo->Unmap (PciIo, AsyncRequest->MapMeta);
+  }
+  if (AsyncRequest->MapPrpList != NULL) {
+    PciIo->Unmap (PciIo, AsyncRequest->MapPrpList);
+  }
+  if (AsyncRequest->PrpListHost != NULL) {
+    PciIo->FreeBuffer (
+             PciIo,
+             AsyncRequest->PrpListNo,
+             AsyncRequest->PrpListHost
+             );
+  }
+
+  RemoveEntryList (&AsyncRequest->Link);
+  gBS->SignalEvent (AsyncRequest->CallerEvent);
+  FreePool (AsyncRequest);
+}
+
+/**
+  Call back function when the timer event is signaled.
+
+  Reaps the completed non-blocking commands from I/O completion queue #2 and
+  signals their callers, fails the commands which have not completed within
+  their timeout, then moves as many of the pending block I/O 2 subtasks as the
+  submission queue can take to the controller.
+
+  @param[in]  Event     The Event this notify function registered to.
+  @param[in]  Context   Pointer to the context data registered to the
+                        Event.
+
+**/
+VOID
+EFIAPI
+ProcessAsyncTaskList (
+  IN EFI_EVENT                    Event,
+  IN VOID*                        Context
+  )
+{
+  NVME_CONTROLLER_PRIVATE_DATA         *Private;
+  EFI_PCI_IO_PROTOCOL                  *PciIo;
+  NVME_CQ                              *Cq;
+  UINT16                               QueueId;
+  UINT32                               Data;
+  LIST_ENTRY                           *Link;
+  LIST_ENTRY                           *NextLink;
+  NVME_PASS_THRU_ASYNC_REQ             *AsyncRequest;
+  NVME_BLKIO2_SUBTASK                  *Subtask;
+  EFI_BLOCK_IO2_TOKEN                  *Token;
+  BOOLEAN                              HasNewItem;
+  EFI_STATUS                           Status;
+
+  Private    = (NVME_CONTROLLER_PRIVATE_DATA*)Context;
+  PciIo      = Private->PciIo;
+  QueueId    = 2;
+  Cq         = Private->CqBuffer[QueueId] + Private->CqHdbl[QueueId].Cqh;
+  HasNewItem = FALSE;
+
+  //
+  // Reap the completed commands from the completion queue.
+  //
+  while (Cq->Pt != Private->Pt[QueueId]) {
+    ASSERT (Cq->Sqid == QueueId);
+
+    HasNewItem = TRUE;
+
+    //
+    // Find the command with the given Command Id.
+    //
+    for (Link = GetFirstNode (&Private->AsyncPassThruQueue);
+         !IsNull (&Private->AsyncPassThruQueue, Link);
+         Link = GetNextNode (&Private->AsyncPassThruQueue, Link)) {
+      AsyncRequest = NVME_PASS_THRU_ASYNC_REQ_FROM_THIS (Link);
+      if (AsyncRequest->CommandId == Cq->Cid) {
+        //
+        // Copy the Respose Queue entry for this command to the callers
+        // response buffer.
+        //
+        CopyMem (
+          AsyncRequest->Packet->NvmeCompletion,
+          Cq,
+          sizeof(EFI_NVM_EXPRESS_COMPLETION)
+          );
+
+        NvmeCompleteAsyncRequest (PciIo, AsyncRequest);
+        break;
+      }
+    }
+
+    //
+    // The controller reports how far it has consumed the submission queue.
+    //
+    Private->AsyncSqHead = Cq->Sqhd;
+
+    Private->CqHdbl[QueueId].Cqh++;
+    if (Private->CqHdbl[QueueId].Cqh > Private->AsyncQueueSize) {
+      Private->CqHdbl[QueueId].Cqh = 0;
+      Private->Pt[QueueId] ^= 1;
+    }
+
+    Cq = Private->CqBuffer[QueueId] + Private->CqHdbl[QueueId].Cqh;
+  }
+
+  if (HasNewItem) {
+    Data  = ReadUnaligned32 ((UINT32*)&Private->CqHdbl[QueueId]);
+    PciIo->Mem.Write (
+                 PciIo,
+                 EfiPciIoWidthUint32,
+                 NVME_BAR,
+                 NVME_CQHDBL_OFFSET(QueueId, Private->Cap.Dstrd),
+                 1,
+                 &Data
+                 );
+  }
+
+  //
+  // Fail the commands which have not completed within their timeout, so that
+  // nobody waits for a command the controller has dropped. A completion
+  // reported later for such a command matches no request and is skipped.
+  //
+  for (Link = GetFirstNode (&Private->AsyncPassThruQueue);
+       !IsNull (&Private->AsyncPassThruQueue, Link);
+       Link = NextLink) {
+    NextLink     = GetNextNode (&Private->AsyncPassThruQueue, Link);
+    AsyncRequest = NVME_PASS_THRU_ASYNC_REQ_FROM_THIS (Link);
+    if (AsyncRequest->Timeout == 0) {
+      continue;
+    }
+
+    if (AsyncRequest->Timeout > NVME_HC_ASYNC_TIMER) {
+      AsyncRequest->Timeout -= NVME_HC_ASYNC_TIMER;
+      continue;
+    }
+
+    DEBUG ((EFI_D_ERROR, "ProcessAsyncTaskList: Command 0x%x timed out\n", AsyncRequest->CommandId));
+    ZeroMem (AsyncRequest->Packet->NvmeCompletion, sizeof (EFI_NVM_EXPRESS_COMPLETION));
+    Cq       = (NVME_CQ *) AsyncRequest->Packet->NvmeCompletion;
+    Cq->Sqid = QueueId;
+    Cq->Cid  = AsyncRequest->CommandId;
+    Cq->Sc   = NVME_ASYNC_TIMEOUT_SC;
+    NvmeCompleteAsyncRequest (PciIo, AsyncRequest);
+  }
+
+  //
+  // Submit the pending subtasks until the submission queue is full.
+  //
+  for (Link = GetFirstNode (&Private->UnsubmittedSubtasks);
+       !IsNull (&Private->UnsubmittedSubtasks, Link);
+       Link = NextLink) {
+    NextLink = GetNextNode (&Private->UnsubmittedSubtasks, Link);
+    Subtask  = NVME_BLKIO2_SUBTASK_FROM_LINK (Link);
+    Token    = Subtask->BlockIo2Request->Token;
+
+    //
+    // If a previous subtask of the same request failed, do not send the
+    // remaining ones to the controller, just complete them.
+    //
+    if (EFI_ERROR (Token->TransactionStatus)) {
+      RemoveEntryList (Link);
+      gBS->SignalEvent (Subtask->Event);
+      continue;
+    }
+
+    Status = Private->Passthru.PassThru (
+                                 &Private->Passthru,
+                                 Subtask->NamespaceId,
+                                 &Subtask->CommandPacket,
+                                 Subtask->Event
+                                 );
+    if (Status == EFI_NOT_READY) {
+      //
+      // The submission queue is full, retry on the next timer tick.
+      //
+      break;
+    }
+
+    RemoveEntryList (Link);
+    if (EFI_ERROR (Status)) {
+      Token->TransactionStatus = EFI_DEVICE_ERROR;
+      gBS->SignalEvent (Subtask->Event);
+    }
+  }
+}
+
 /**
   Tests to see if this driver supports a given controller. If a child device is provided,
   it further tests to see if this driver supports creating a handle for the specified child device.
@@ -728,19 +956,21 @@ NvmExpressDriverBindingStart (
     }
 
     //
-    // 4 x 4kB aligned buffers will be carved out of this buffer.
+    // 6 x 4kB aligned buffers will be carved out of this buffer.
     // 1st 4kB boundary is the start of the admin submission queue.
     // 2nd 4kB boundary is the start of the admin completion queue.
     // 3rd 4kB boundary is the start of I/O submission queue #1.
     // 4th 4kB boundary is the start of I/O completion queue #1.
+    // 5th 4kB boundary is the start of I/O submission queue #2.
+    // 6th 4kB boundary is the start of I/O completion queue #2.
     //
-    // Allocate 4 pages of memory, then map it for bus master read and write.
+    // Allocate 6 pages of memory, then map it for bus master read and write.
     //
     Status = PciIo->AllocateBuffer (
                       PciIo,
                       AllocateAnyPages,
                       EfiBootServicesData,
-                      4,
+                      6,
                       (VOID**)&Private->Buffer,
                       0
                       );
@@ -748,7 +978,7 @@ NvmExpressDriverBindingStart (
       goto Exit;
     }
 
-    Bytes = EFI_PAGES_TO_SIZE (4);
+    Bytes = EFI_PAGES_TO_SIZE (6);
     Status = PciIo->Map (
                       PciIo,
                       EfiPciIoOperationBusMasterCommonBuffer,
@@ -758,12 +988,12 @@ NvmExpressDriverBindingStart (
                       &Private->Mapping
                       );
 
-    if (EFI_ERROR (Status) || (Bytes != EFI_PAGES_TO_SIZE (4))) {
+    if (EFI_ERROR (Status) || (Bytes != EFI_PAGES_TO_SIZE (6))) {
       goto Exit;
     }
 
     Private->BufferPciAddr = (UINT8 *)(UINTN)MappedAddr;
-    ZeroMem (Private->Buffer, EFI_PAGES_TO_SIZE (4));
+    ZeroMem (Private->Buffer, EFI_PAGES_TO_SIZE (6));
 
     Private->Signature = NVME_CONTROLLER_PRIVATE_DATA_SIGNATURE;
     Private->ControllerHandle          = Controller;
@@ -777,12 +1007,37 @@ NvmExpressDriverBindingStart (
     Private->Passthru.BuildDevicePath  = NvmExpressBuildDevicePath;
     Private->Passthru.GetNamespace     = NvmExpressGetNamespace;
     CopyMem (&Private->PassThruMode, &gEfiNvmExpressPassThruMode, sizeof (EFI_NVM_EXPRESS_PASS_THRU_MODE));
+    InitializeListHead (&Private->AsyncPassThruQueue);
+    InitializeListHead (&Private->UnsubmittedSubtasks);
 
     Status = NvmeControllerInit (Private);
     if (EFI_ERROR(Status)) {
       goto Exit;
     }
 
+    //
+    // Start the asynchronous I/O completion monitor
+    //
+    Status = gBS->CreateEvent (
+                    EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                    TPL_NOTIFY,
+                    ProcessAsyncTaskList,
+                    Private,
+                    &Private->TimerEvent
+                    );
+    if (EFI_ERROR (Status)) {
+      goto Exit;
+    }
+
+    Status = gBS->SetTimer (
+                    Private->TimerEvent,
+                    TimerPeriodic,
+                    NVME_HC_ASYNC_TIMER
+                    );
+    if (EFI_ERROR (Status)) {
+      goto Exit;
+    }
+
     Status = gBS->InstallMultipleProtocolInterfaces (
                     &Controller,
                     &gEfiNvmExpressPassThruProtocolGuid,
@@ -838,12 +1093,20 @@ NvmExpressDriverBindingStart (
   return EFI_SUCCESS;
 
 Exit:
+  //
+  // Close the timer event processing the asynchronous PassThru queue before
+  // the queues it reads are freed.
+  //
+  if ((Private != NULL) && (Private->TimerEvent != NULL)) {
+    gBS->CloseEvent (Private->TimerEvent);
+  }
+
   if ((Private != NULL) && (Private->Mapping != NULL)) {
     PciIo->Unmap (PciIo, Private->Mapping);
   }
 
   if ((Private != NULL) && (Private->Buffer != NULL)) {
-    PciIo->FreeBuffer (PciIo, 4, Private->Buffer);
+    PciIo->FreeBuffer (PciIo, 6, Private->Buffer);
   }
 
   if (Private != NULL) {
@@ -923,6 +1186,16 @@ NvmExpressDriverBindingStop (
 
     if (!EFI_ERROR (Status)) {
       Private = NVME_CONTROLLER_PRIVATE_DATA_FROM_PASS_THRU (PassThru);
+
+      //
+      // Wait for the asynchronous PassThru queue to become empty. The
+      // requests still queued reference the controller data.
+      //
+      Status = NvmeWaitAsyncQueueEmpty (Private, NULL);
+      if (EFI_ERROR (Status)) {
+        return EFI_DEVICE_ERROR;
+      }
+
       gBS->UninstallMultipleProtocolInterfaces (
             Controller,
             &gEfiNvmExpressPassThruProtocolGuid,
@@ -930,12 +1203,16 @@ NvmExpressDriverBindingStop (
             NULL
             );
 
+      if (Private->TimerEvent != NULL) {
+        gBS->CloseEvent (Private->TimerEvent);
+      }
+
       if (Private->Mapping != NULL) {
         Private->PciIo->Unmap (Private->PciIo, Private->Mapping);
       }
 
       if (Private->Buffer != NULL) {
-        Private->PciIo->FreeBuffer (Private->PciIo, 4, Private->Buffer);
+        Private->PciIo->FreeBuffer (Private->PciIo, 6, Private->Buffer);
       }
 
       FreePool (Private->ControllerData);
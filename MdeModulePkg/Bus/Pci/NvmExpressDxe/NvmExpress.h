@@ -28,6 +28,7 @@
 #include <Protocol/PciIo.h>
 #include <Protocol/NvmExpressPassthru.h>
 #include <Protocol/BlockIo.h>
+#include <Protocol/BlockIo2.h>
 #include <Protocol/DiskInfo.h>
 #include <Protocol/DriverSupportedEfiVersion.h>
 #include <Protocol/StorageSecurityCommand.h>
@@ -63,7 +64,14 @@ extern EFI_DRIVER_SUPPORTED_EFI_VERSION_PROTOCOL  gNvmExpressDriverSupportedEfiV
 #define NVME_CSQ_SIZE                             1     // Number of I/O submission queue entries, which is 0-based
 #define NVME_CCQ_SIZE                             1     // Number of I/O completion queue entries, which is 0-based
 
-#define NVME_MAX_QUEUES                           2     // Number of queues supported by the driver
+//
+// Number of asynchronous I/O submission & completion queue entries, which is 0-based.
+// The actual queue size is also limited by CAP.MQES of the controller.
+//
+#define NVME_ASYNC_CSQ_SIZE                       63
+#define NVME_ASYNC_CCQ_SIZE                       63
+
+#define NVME_MAX_QUEUES                           3     // Number of queues supported by the driver
 
 #define NVME_CONTROLLER_ID                        0
 
@@ -72,6 +80,18 @@ extern EFI_DRIVER_SUPPORTED_EFI_VERSION_PROTOCOL  gNvmExpressDriverSupportedEfiV
 //
 #define NVME_GENERIC_TIMEOUT                      EFI_TIMER_PERIOD_SECONDS (5)
 
+//
+// Nvme async transfer timer interval, set by experience.
+//
+#define NVME_HC_ASYNC_TIMER                       EFI_TIMER_PERIOD_MILLISECONDS (1)
+
+//
+// Status code put in the completion of a non-blocking command that does not
+// complete within its timeout, "Command Abort Requested" of the generic
+// command status type.
+//
+#define NVME_ASYNC_TIMEOUT_SC                     0x07
+
 //
 // Unique signature for private data structure.
 //
@@ -103,11 +123,11 @@ struct _NVME_CONTROLLER_PRIVATE_DATA {
   //
   // 6 x 4kB aligned buffers will be carved out of this buffer.
   // 1st 4kB boundary is the start of the admin submission queue.
-  // 2nd 4kB boundary is the start of the I/O submission queue #1.
-  // 3rd 4kB boundary is the start of the admin completion queue.
-  // 4th 4kB boundary is the start of the I/O completion queue #1.
-  // 5th 4kB boundary is the start of the first PRP list page.
-  // 6th 4kB boundary is the start of the second PRP list page.
+  // 2nd 4kB boundary is the start of the admin completion queue.
+  // 3rd 4kB boundary is the start of I/O submission queue #1.
+  // 4th 4kB boundary is the start of I/O completion queue #1.
+  // 5th 4kB boundary is the start of I/O submission queue #2.
+  // 6th 4kB boundary is the start of I/O completion queue #2.
   //
   UINT8                               *Buffer;
   UINT8                               *BufferPciAddr;
@@ -135,6 +155,21 @@ struct _NVME_CONTROLLER_PRIVATE_DATA {
   NVME_CAP                            Cap;
 
   VOID                                *Mapping;
+
+  //
+  // For Non-blocking operations.
+  //
+  EFI_EVENT                           TimerEvent;
+  //
+  // Number of entries of I/O submission & completion queue #2, which is 0-based.
+  //
+  UINT16                              AsyncQueueSize;
+  //
+  // Submission queue #2 head pointer last reported by the controller.
+  //
+  UINT16                              AsyncSqHead;
+  LIST_ENTRY                          AsyncPassThruQueue;
+  LIST_ENTRY                          UnsubmittedSubtasks;
 };
 
 #define NVME_CONTROLLER_PRIVATE_DATA_FROM_PASS_THRU(a) \
@@ -168,6 +203,7 @@ struct _NVME_DEVICE_PRIVATE_DATA {
 
   EFI_BLOCK_IO_MEDIA                       Media;
   EFI_BLOCK_IO_PROTOCOL                    BlockIo;
+  EFI_BLOCK_IO2_PROTOCOL                   BlockIo2;
   EFI_DISK_INFO_PROTOCOL                   DiskInfo;
   EFI_STORAGE_SECURITY_COMMAND_PROTOCOL    StorageSecurity;
 
@@ -178,6 +214,10 @@ struct _NVME_DEVICE_PRIVATE_DATA {
 
   NVME_CONTROLLER_PRIVATE_DATA             *Controller;
 
+  //
+  // For Non-blocking operations.
+  //
+  LIST_ENTRY                               AsyncQueue;
 };
 
 //
@@ -190,6 +230,13 @@ struct _NVME_DEVICE_PRIVATE_DATA {
       NVME_DEVICE_PRIVATE_DATA_SIGNATURE \
       )
 
+#define NVME_DEVICE_PRIVATE_DATA_FROM_BLOCK_IO2(a) \
+  CR (a, \
+      NVME_DEVICE_PRIVATE_DATA, \
+      BlockIo2, \
+      NVME_DEVICE_PRIVATE_DATA_SIGNATURE \
+      )
+
 #define NVME_DEVICE_PRIVATE_DATA_FROM_DISK_INFO(a) \
   CR (a, \
       NVME_DEVICE_PRIVATE_DATA, \
@@ -204,6 +251,75 @@ struct _NVME_DEVICE_PRIVATE_DATA {
       NVME_DEVICE_PRIVATE_DATA_SIGNATURE                 \
       )
 
+//
+// Nvme block I/O 2 request.
+//
+#define NVME_BLKIO2_REQUEST_SIGNATURE      SIGNATURE_32 ('N', 'B', '2', 'R')
+
+typedef struct {
+  UINT32                                   Signature;
+  LIST_ENTRY                               Link;
+
+  EFI_BLOCK_IO2_TOKEN                      *Token;
+  //
+  // Number of subtasks of this request that have not completed yet.
+  //
+  UINTN                                    PendingSubtasks;
+} NVME_BLKIO2_REQUEST;
+
+#define NVME_BLKIO2_REQUEST_FROM_LINK(a) \
+  CR (a, NVME_BLKIO2_REQUEST, Link, NVME_BLKIO2_REQUEST_SIGNATURE)
+
+//
+// Nvme block I/O 2 subtask, one NVMe command of a block I/O 2 request.
+//
+#define NVME_BLKIO2_SUBTASK_SIGNATURE      SIGNATURE_32 ('N', 'B', '2', 'S')
+
+typedef struct {
+  UINT32                                   Signature;
+  LIST_ENTRY                               Link;
+
+  UINT32                                   NamespaceId;
+  EFI_EVENT                                Event;
+  EFI_NVM_EXPRESS_PASS_THRU_COMMAND_PACKET CommandPacket;
+  EFI_NVM_EXPRESS_COMMAND                  Command;
+  EFI_NVM_EXPRESS_COMPLETION               Completion;
+  //
+  // The block I/O 2 request this subtask belongs to.
+  //
+  NVME_BLKIO2_REQUEST                      *BlockIo2Request;
+} NVME_BLKIO2_SUBTASK;
+
+#define NVME_BLKIO2_SUBTASK_FROM_LINK(a) \
+  CR (a, NVME_BLKIO2_SUBTASK, Link, NVME_BLKIO2_SUBTASK_SIGNATURE)
+
+//
+// Nvme asynchronous passthru request.
+//
+#define NVME_PASS_THRU_ASYNC_REQ_SIG       SIGNATURE_32 ('N', 'P', 'A', 'R')
+
+typedef struct {
+  UINT32                                   Signature;
+  LIST_ENTRY                               Link;
+
+  EFI_NVM_EXPRESS_PASS_THRU_COMMAND_PACKET *Packet;
+  UINT16                                   CommandId;
+  VOID                                     *MapPrpList;
+  UINTN                                    PrpListNo;
+  VOID                                     *PrpListHost;
+  VOID                                     *MapData;
+  VOID                                     *MapMeta;
+  EFI_EVENT                                CallerEvent;
+  //
+  // The time left for the command to complete, in 100ns units. 0 means the
+  // command does not time out.
+  //
+  UINT64                                   Timeout;
+} NVME_PASS_THRU_ASYNC_REQ;
+
+#define NVME_PASS_THRU_ASYNC_REQ_FROM_THIS(a) \
+  CR (a, NVME_PASS_THRU_ASYNC_REQ, Link, NVME_PASS_THRU_ASYNC_REQ_SIG)
+
 /**
   Retrieves a Unicode string that is the user readable name of the driver.
 
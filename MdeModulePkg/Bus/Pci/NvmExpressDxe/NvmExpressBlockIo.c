@@ -310,6 +310,249 @@ NvmeFlush (
   return Status;
 }
 
+/**
+  Nonblocking I/O callback funtion when the event is signaled.
+
+  @param[in]  Event     The Event this notify function registered to.
+  @param[in]  Context   Pointer to the context data registered to the
+                        Event.
+
+**/
+VOID
+EFIAPI
+AsyncIoCallback (
+  IN EFI_EVENT                Event,
+  IN VOID                     *Context
+  )
+{
+  NVME_BLKIO2_SUBTASK         *Subtask;
+  NVME_BLKIO2_REQUEST         *Request;
+  NVME_CQ                     *Completion;
+  EFI_BLOCK_IO2_TOKEN         *Token;
+
+  gBS->CloseEvent (Event);
+
+  Subtask    = (NVME_BLKIO2_SUBTASK *) Context;
+  Completion = (NVME_CQ *) &Subtask->Completion;
+  Request    = Subtask->BlockIo2Request;
+  Token      = Request->Token;
+
+  //
+  // Check the command status. A subtask which was never sent to the controller
+  // keeps a zeroed completion, its failure has already been put in the token.
+  // A command which did not complete within its timeout is reported with
+  // NVME_ASYNC_TIMEOUT_SC by the asynchronous task timer.
+  //
+  if ((Completion->Sct != 0) || (Completion->Sc != 0)) {
+    DEBUG ((EFI_D_ERROR, "%a: Sct = 0x%x, Sc = 0x%x\n", __FUNCTION__, Completion->Sct, Completion->Sc));
+    if ((Completion->Sct == 0) && (Completion->Sc == NVME_ASYNC_TIMEOUT_SC)) {
+      Token->TransactionStatus = EFI_TIMEOUT;
+    } else {
+      Token->TransactionStatus = EFI_DEVICE_ERROR;
+    }
+  }
+
+  FreePool (Subtask);
+
+  //
+  // Signal the caller once the last subtask of the request is done.
+  //
+  Request->PendingSubtasks--;
+  if (Request->PendingSubtasks == 0) {
+    RemoveEntryList (&Request->Link);
+    gBS->SignalEvent (Token->Event);
+    FreePool (Request);
+  }
+}
+
+/**
+  Read or write some blocks from/to the device in non-blocking mode.
+
+  The transfer is split into subtasks which fit in a single NVMe command each.
+  All the subtasks are queued at once and sent by the asynchronous task timer,
+  so that as many of them as the I/O submission queue #2 can hold are in flight
+  at the same time.
+
+  @param  Device                 The pointer to the NVME_DEVICE_PRIVATE_DATA data structure.
+  @param  IsRead                 Indicates whether it is a read operation or not.
+  @param  Buffer                 The buffer to transfer the data from or to.
+  @param  Lba                    The start block number.
+  @param  Blocks                 Total block number to be transferred.
+  @param  Token                  A pointer to the token associated with the transaction.
+
+  @retval EFI_SUCCESS            The request is queued.
+  @retval EFI_OUT_OF_RESOURCES   The request could not be queued due to a lack of resources.
+
+**/
+EFI_STATUS
+NvmeAsyncReadWrite (
+  IN NVME_DEVICE_PRIVATE_DATA           *Device,
+  IN BOOLEAN                            IsRead,
+  IN VOID                               *Buffer,
+  IN UINT64                             Lba,
+  IN UINTN                              Blocks,
+  IN EFI_BLOCK_IO2_TOKEN                *Token
+  )
+{
+  EFI_STATUS                       Status;
+  UINT32                           BlockSize;
+  NVME_CONTROLLER_PRIVATE_DATA     *Private;
+  UINT32                           MaxTransferBlocks;
+  UINT32                           NumberOfBlocks;
+  NVME_BLKIO2_REQUEST              *Request;
+  NVME_BLKIO2_SUBTASK              *Subtask;
+  LIST_ENTRY                       Subtasks;
+  LIST_ENTRY                       *Link;
+  EFI_TPL                          OldTpl;
+
+  Private   = Device->Controller;
+  BlockSize = Device->Media.BlockSize;
+
+  if (Private->ControllerData->Mdts != 0) {
+    MaxTransferBlocks = (1 << (Private->ControllerData->Mdts)) * (1 << (Private->Cap.Mpsmin + 12)) / BlockSize;
+  } else {
+    MaxTransferBlocks = 1024;
+  }
+
+  Request = AllocateZeroPool (sizeof (NVME_BLKIO2_REQUEST));
+  if (Request == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Request->Signature = NVME_BLKIO2_REQUEST_SIGNATURE;
+  Request->Token     = Token;
+  InitializeListHead (&Subtasks);
+
+  while (Blocks > 0) {
+    NumberOfBlocks = (UINT32) MIN (Blocks, MaxTransferBlocks);
+
+    Subtask = AllocateZeroPool (sizeof (NVME_BLKIO2_SUBTASK));
+    if (Subtask == NULL) {
+      Status = EFI_OUT_OF_RESOURCES;
+      goto ErrorExit;
+    }
+
+    Subtask->Signature       = NVME_BLKIO2_SUBTASK_SIGNATURE;
+    Subtask->NamespaceId     = Device->NamespaceId;
+    Subtask->BlockIo2Request = Request;
+    InsertTailList (&Subtasks, &Subtask->Link);
+
+    Subtask->CommandPacket.NvmeCmd        = &Subtask->Command;
+    Subtask->CommandPacket.NvmeCompletion = &Subtask->Completion;
+
+    Subtask->Command.Cdw0.Opcode = IsRead ? NVME_IO_READ_OPC : NVME_IO_WRITE_OPC;
+    Subtask->Command.Nsid        = Device->NamespaceId;
+    Subtask->CommandPacket.TransferBuffer = Buffer;
+
+    Subtask->CommandPacket.TransferLength = NumberOfBlocks * BlockSize;
+    Subtask->CommandPacket.CommandTimeout = NVME_GENERIC_TIMEOUT;
+    Subtask->CommandPacket.QueueType      = NVME_IO_QUEUE;
+
+    Subtask->Command.Cdw10 = (UINT32)Lba;
+    Subtask->Command.Cdw11 = (UINT32)RShiftU64(Lba, 32);
+    Subtask->Command.Cdw12 = (NumberOfBlocks - 1) & 0xFFFF;
+
+    Subtask->Command.Flags = CDW10_VALID | CDW11_VALID | CDW12_VALID;
+
+    Status = gBS->CreateEvent (
+                    EVT_NOTIFY_SIGNAL,
+                    TPL_NOTIFY,
+                    AsyncIoCallback,
+                    Subtask,
+                    &Subtask->Event
+                    );
+    if (EFI_ERROR (Status)) {
+      goto ErrorExit;
+    }
+
+    Request->PendingSubtasks++;
+
+    Blocks -= NumberOfBlocks;
+    Buffer  = (VOID *)(UINTN)((UINT64)(UINTN)Buffer + NumberOfBlocks * BlockSize);
+    Lba    += NumberOfBlocks;
+  }
+
+  //
+  // Queue the request together with all of its subtasks, so the request can
+  // not be completed before the last subtask is queued.
+  //
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  InsertTailList (&Device->AsyncQueue, &Request->Link);
+  while (!IsListEmpty (&Subtasks)) {
+    Link = GetFirstNode (&Subtasks);
+    RemoveEntryList (Link);
+    InsertTailList (&Private->UnsubmittedSubtasks, Link);
+  }
+  gBS->RestoreTPL (OldTpl);
+
+  return EFI_SUCCESS;
+
+ErrorExit:
+  while (!IsListEmpty (&Subtasks)) {
+    Link    = GetFirstNode (&Subtasks);
+    Subtask = NVME_BLKIO2_SUBTASK_FROM_LINK (Link);
+    RemoveEntryList (Link);
+    if (Subtask->Event != NULL) {
+      gBS->CloseEvent (Subtask->Event);
+    }
+    FreePool (Subtask);
+  }
+  FreePool (Request);
+
+  return Status;
+}
+
+/**
+  Wait for the non-blocking requests of the controller, or of one of its
+  namespaces, to complete.
+
+  The requests are completed by the asynchronous task timer, which runs at
+  TPL_NOTIFY, so this must be called below TPL_NOTIFY.
+
+  @param  Private                The pointer to the NVME_CONTROLLER_PRIVATE_DATA data structure.
+  @param  Device                 The pointer to the NVME_DEVICE_PRIVATE_DATA data structure
+                                 of the namespace to wait for, or NULL to wait for all the
+                                 requests of the controller.
+
+  @retval EFI_SUCCESS            All the non-blocking requests are completed.
+  @retval EFI_TIMEOUT            The requests are not completed within
+                                 NVME_GENERIC_TIMEOUT.
+
+**/
+EFI_STATUS
+NvmeWaitAsyncQueueEmpty (
+  IN NVME_CONTROLLER_PRIVATE_DATA       *Private,
+  IN NVME_DEVICE_PRIVATE_DATA           *Device    OPTIONAL
+  )
+{
+  BOOLEAN                          IsEmpty;
+  EFI_TPL                          OldTpl;
+  UINT64                           Timer;
+
+  //
+  // NVME_GENERIC_TIMEOUT is in 100ns units, the requests are checked every 100us.
+  //
+  for (Timer = 0; Timer < NVME_GENERIC_TIMEOUT; Timer += 1000) {
+    OldTpl  = gBS->RaiseTPL (TPL_NOTIFY);
+    ASSERT (OldTpl < TPL_NOTIFY);
+    if (Device != NULL) {
+      IsEmpty = IsListEmpty (&Device->AsyncQueue);
+    } else {
+      IsEmpty = IsListEmpty (&Private->AsyncPassThruQueue) &&
+                IsListEmpty (&Private->UnsubmittedSubtasks);
+    }
+    gBS->RestoreTPL (OldTpl);
+
+    if (IsEmpty) {
+      return EFI_SUCCESS;
+    }
+
+    gBS->Stall (100);
+  }
+
+  DEBUG ((EFI_D_ERROR, "NvmeWaitAsyncQueueEmpty: Non-blocking requests not completed\n"));
+  return EFI_TIMEOUT;
+}
 
 /**
   Reset the Block Device.
@@ -338,15 +581,24 @@ NvmeBlockIoReset (
     return EFI_INVALID_PARAMETER;
   }
 
+  Device  = NVME_DEVICE_PRIVATE_DATA_FROM_BLOCK_IO (This);
+
+  Private = Device->Controller;
+
+  //
+  // Reinitializing the controller discards its queues, so let the commands
+  // still in flight complete first.
+  //
+  Status = NvmeWaitAsyncQueueEmpty (Private, NULL);
+  if (EFI_ERROR (Status)) {
+    return EFI_DEVICE_ERROR;
+  }
+
   //
   // For Nvm Express subsystem, reset block device means reset controller.
   //
   OldTpl  = gBS->RaiseTPL (TPL_CALLBACK);
 
-  Device  = NVME_DEVICE_PRIVATE_DATA_FROM_BLOCK_IO (This);
-
-  Private = Device->Controller;
-
   Status  = NvmeControllerInit (Private);
 
   if (EFI_ERROR (Status)) {
@@ -564,6 +816,321 @@ NvmeBlockIoFlushBlocks (
   return Status;
 }
 
+/**
+  Reset the block device hardware.
+
+  @param[in]  This                 Indicates a pointer to the calling context.
+  @param[in]  ExtendedVerification Indicates that the driver may perform a more
+                                   exhausive verfication operation of the
+                                   device during reset.
+
+  @retval EFI_SUCCESS          The device was reset.
+  @retval EFI_DEVICE_ERROR     The device is not functioning properly and could
+                               not be reset.
+
+**/
+EFI_STATUS
+EFIAPI
+NvmeBlockIoResetEx (
+  IN  EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN  BOOLEAN                 ExtendedVerification
+  )
+{
+  NVME_DEVICE_PRIVATE_DATA        *Device;
+
+  if (This == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Device = NVME_DEVICE_PRIVATE_DATA_FROM_BLOCK_IO2 (This);
+
+  return NvmeBlockIoReset (&Device->BlockIo, ExtendedVerification);
+}
+
+/**
+  Read BufferSize bytes from Lba into Buffer.
+
+  This function reads the requested number of blocks from the device. All the
+  blocks are read, or an error is returned.
+  If there is no media in the device, the function returns EFI_NO_MEDIA. If the
+  MediaId is not the ID for the current media in the device, the function returns
+  EFI_MEDIA_CHANGED. The function must return EFI_NO_MEDIA or EFI_MEDIA_CHANGED
+  even if LBA, BufferSize, or Buffer are invalid so the caller can probe for
+  changes in media state.
+
+  @param[in]       This       Indicates a pointer to the calling context.
+  @param[in]       MediaId    The media ID that the read request is for.
+  @param[in]       Lba        The starting logical block address to be read.
+                              The caller is responsible for reading from only
+                              legitimate locations.
+  @param[in, out]  Token      A pointer to the token associated with the
+                              transaction.
+  @param[in]       BufferSize The size in bytes of Buffer. This must be a multiple
+                              of the intrinsic block size of the device.
+  @param[out]      Buffer     A pointer to the destination buffer for the data.
+                              The caller is responsible for either having
+                              implicit or explicit ownership of the buffer.
+
+  @retval EFI_SUCCESS             The read request was queued if Token->Event
+                                  is not NULL. The data was read correctly
+                                  from the device if the Token->Event is NULL.
+  @retval EFI_DEVICE_ERROR        The device reported an error while attempting
+                                  to perform the read operation.
+  @retval EFI_NO_MEDIA            There is no media in the device.
+  @retval EFI_MEDIA_CHANGED       The MediaId is not for the current media.
+  @retval EFI_BAD_BUFFER_SIZE     The BufferSize parameter is not a multiple of
+                                  the intrinsic block size of the device.
+  @retval EFI_INVALID_PARAMETER   The read request contains LBAs that are not
+                                  valid, or the buffer is not on proper
+                                  alignment.
+  @retval EFI_OUT_OF_RESOURCES    The request could not be completed due to a
+                                  lack of resources.
+
+**/
+EFI_STATUS
+EFIAPI
+NvmeBlockIoReadBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN     UINT32                  MediaId,
+  IN     EFI_LBA                 Lba,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token,
+  IN     UINTN                   BufferSize,
+     OUT VOID                    *Buffer
+  )
+{
+  NVME_DEVICE_PRIVATE_DATA          *Device;
+  EFI_STATUS                        Status;
+  EFI_BLOCK_IO_MEDIA                *Media;
+  UINTN                             BlockSize;
+  UINTN                             NumberOfBlocks;
+  UINTN                             IoAlign;
+  EFI_TPL                           OldTpl;
+
+  //
+  // Check parameters.
+  //
+  if (This == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Media = This->Media;
+
+  if (MediaId != Media->MediaId) {
+    return EFI_MEDIA_CHANGED;
+  }
+
+  if (Buffer == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (BufferSize == 0) {
+    if ((Token != NULL) && (Token->Event != NULL)) {
+      Token->TransactionStatus = EFI_SUCCESS;
+      gBS->SignalEvent (Token->Event);
+    }
+    return EFI_SUCCESS;
+  }
+
+  BlockSize = Media->BlockSize;
+  if ((BufferSize % BlockSize) != 0) {
+    return EFI_BAD_BUFFER_SIZE;
+  }
+
+  NumberOfBlocks  = BufferSize / BlockSize;
+  if ((Lba + NumberOfBlocks - 1) > Media->LastBlock) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  IoAlign = Media->IoAlign;
+  if (IoAlign > 0 && (((UINTN) Buffer & (IoAlign - 1)) != 0)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Device = NVME_DEVICE_PRIVATE_DATA_FROM_BLOCK_IO2 (This);
+
+  if ((Token != NULL) && (Token->Event != NULL)) {
+    Token->TransactionStatus = EFI_SUCCESS;
+    Status = NvmeAsyncReadWrite (Device, TRUE, Buffer, Lba, NumberOfBlocks, Token);
+  } else {
+    OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+    Status = NvmeRead (Device, Buffer, Lba, NumberOfBlocks);
+    gBS->RestoreTPL (OldTpl);
+  }
+
+  return Status;
+}
+
+/**
+  Write BufferSize bytes from Buffer into Lba.
+
+  This function writes the requested number of blocks to the device. All blocks
+  are written, or an error is returned.
+  If there is no media in the device, the function returns EFI_NO_MEDIA. If the
+  MediaId is not the ID for the current media in the device, the function returns
+  EFI_MEDIA_CHANGED. The function must return EFI_NO_MEDIA or EFI_MEDIA_CHANGED
+  even if LBA, BufferSize, or Buffer are invalid so the caller can probe for
+  changes in media state.
+
+  @param[in]       This       Indicates a pointer to the calling context.
+  @param[in]       MediaId    The media ID that the write request is for.
+  @param[in]       Lba        The starting logical block address to be written.
+                              The caller is responsible for writing to only
+                              legitimate locations.
+  @param[in, out]  Token      A pointer to the token associated with the
+                              transaction.
+  @param[in]       BufferSize The size in bytes of Buffer. This must be a multiple
+                              of the intrinsic block size of the device.
+  @param[in]       Buffer     A pointer to the source buffer for the data.
+                              The caller is responsible for either having
+                              implicit or explicit ownership of the buffer.
+
+  @retval EFI_SUCCESS             The write request was queued if Token->Event
+                                  is not NULL. The data was written correctly
+                                  to the device if the Token->Event is NULL.
+  @retval EFI_DEVICE_ERROR        The device reported an error while attempting
+                                  to perform the write operation.
+  @retval EFI_NO_MEDIA            There is no media in the device.
+  @retval EFI_MEDIA_CHANGED       The MediaId is not for the current media.
+  @retval EFI_BAD_BUFFER_SIZE     The BufferSize parameter is not a multiple of
+                                  the intrinsic block size of the device.
+  @retval EFI_INVALID_PARAMETER   The write request contains LBAs that are not
+                                  valid, or the buffer is not on proper
+                                  alignment.
+  @retval EFI_OUT_OF_RESOURCES    The request could not be completed due to a
+                                  lack of resources.
+
+**/
+EFI_STATUS
+EFIAPI
+NvmeBlockIoWriteBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN     UINT32                  MediaId,
+  IN     EFI_LBA                 Lba,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token,
+  IN     UINTN                   BufferSize,
+  IN     VOID                    *Buffer
+  )
+{
+  NVME_DEVICE_PRIVATE_DATA          *Device;
+  EFI_STATUS                        Status;
+  EFI_BLOCK_IO_MEDIA                *Media;
+  UINTN                             BlockSize;
+  UINTN                             NumberOfBlocks;
+  UINTN                             IoAlign;
+  EFI_TPL                           OldTpl;
+
+  //
+  // Check parameters.
+  //
+  if (This == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Media = This->Media;
+
+  if (MediaId != Media->MediaId) {
+    return EFI_MEDIA_CHANGED;
+  }
+
+  if (Buffer == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (BufferSize == 0) {
+    if ((Token != NULL) && (Token->Event != NULL)) {
+      Token->TransactionStatus = EFI_SUCCESS;
+      gBS->SignalEvent (Token->Event);
+    }
+    return EFI_SUCCESS;
+  }
+
+  BlockSize = Media->BlockSize;
+  if ((BufferSize % BlockSize) != 0) {
+    return EFI_BAD_BUFFER_SIZE;
+  }
+
+  NumberOfBlocks  = BufferSize / BlockSize;
+  if ((Lba + NumberOfBlocks - 1) > Media->LastBlock) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  IoAlign = Media->IoAlign;
+  if (IoAlign > 0 && (((UINTN) Buffer & (IoAlign - 1)) != 0)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Device = NVME_DEVICE_PRIVATE_DATA_FROM_BLOCK_IO2 (This);
+
+  if ((Token != NULL) && (Token->Event != NULL)) {
+    Token->TransactionStatus = EFI_SUCCESS;
+    Status = NvmeAsyncReadWrite (Device, FALSE, Buffer, Lba, NumberOfBlocks, Token);
+  } else {
+    OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+    Status = NvmeWrite (Device, Buffer, Lba, NumberOfBlocks);
+    gBS->RestoreTPL (OldTpl);
+  }
+
+  return Status;
+}
+
+/**
+  Flush the Block Device.
+
+  If EFI_DEVICE_ERROR, EFI_NO_MEDIA, EFI_WRITE_PROTECTED or EFI_MEDIA_CHANGED
+  is returned and non-blocking I/O is being used, the Event associated with
+  this request will not be signaled.
+
+  @param[in]      This     Indicates a pointer to the calling context.
+  @param[in,out]  Token    A pointer to the token associated with the
+                           transaction.
+
+  @retval EFI_SUCCESS          The flush request was queued if Event is not
+                               NULL. All outstanding data was written
+                               correctly to the device if the Event is NULL.
+  @retval EFI_DEVICE_ERROR     The device reported an error while writting back
+                               the data.
+  @retval EFI_WRITE_PROTECTED  The device cannot be written to.
+  @retval EFI_NO_MEDIA         There is no media in the device.
+  @retval EFI_MEDIA_CHANGED    The MediaId is not for the current media.
+  @retval EFI_OUT_OF_RESOURCES The request could not be completed due to a lack
+                               of resources.
+
+**/
+EFI_STATUS
+EFIAPI
+NvmeBlockIoFlushBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL   *This,
+  IN OUT EFI_BLOCK_IO2_TOKEN      *Token
+  )
+{
+  NVME_DEVICE_PRIVATE_DATA          *Device;
+  EFI_STATUS                        Status;
+
+  if (This == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Device = NVME_DEVICE_PRIVATE_DATA_FROM_BLOCK_IO2 (This);
+
+  //
+  // The flush command has to be issued after all the non-blocking writes
+  // queued before it have reached the device.
+  //
+  Status = NvmeWaitAsyncQueueEmpty (Device->Controller, NULL);
+  if (EFI_ERROR (Status)) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  Status = NvmeBlockIoFlushBlocks (&Device->BlockIo);
+
+  if ((Token != NULL) && (Token->Event != NULL) && !EFI_ERROR (Status)) {
+    Token->TransactionStatus = Status;
+    gBS->SignalEvent (Token->Event);
+  }
+
+  return Status;
+}
+
 /**
   Trust transfer data from/to NVMe device.
 
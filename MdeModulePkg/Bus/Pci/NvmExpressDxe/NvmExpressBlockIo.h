@@ -108,6 +108,181 @@ NvmeBlockIoFlushBlocks (
   IN  EFI_BLOCK_IO_PROTOCOL   *This
   );
 
+/**
+  Reset the block device hardware.
+
+  @param[in]  This                 Indicates a pointer to the calling context.
+  @param[in]  ExtendedVerification Indicates that the driver may perform a more
+                                   exhausive verfication operation of the
+                                   device during reset.
+
+  @retval EFI_SUCCESS          The device was reset.
+  @retval EFI_DEVICE_ERROR     The device is not functioning properly and could
+                               not be reset.
+
+**/
+EFI_STATUS
+EFIAPI
+NvmeBlockIoResetEx (
+  IN  EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN  BOOLEAN                 ExtendedVerification
+  );
+
+/**
+  Read BufferSize bytes from Lba into Buffer.
+
+  This function reads the requested number of blocks from the device. All the
+  blocks are read, or an error is returned.
+  If there is no media in the device, the function returns EFI_NO_MEDIA. If the
+  MediaId is not the ID for the current media in the device, the function returns
+  EFI_MEDIA_CHANGED. The function must return EFI_NO_MEDIA or EFI_MEDIA_CHANGED
+  even if LBA, BufferSize, or Buffer are invalid so the caller can probe for
+  changes in media state.
+
+  @param[in]       This       Indicates a pointer to the calling context.
+  @param[in]       MediaId    The media ID that the read request is for.
+  @param[in]       Lba        The starting logical block address to be read.
+                              The caller is responsible for reading from only
+                              legitimate locations.
+  @param[in, out]  Token      A pointer to the token associated with the
+                              transaction.
+  @param[in]       BufferSize The size in bytes of Buffer. This must be a multiple
+                              of the intrinsic block size of the device.
+  @param[out]      Buffer     A pointer to the destination buffer for the data.
+                              The caller is responsible for either having
+                              implicit or explicit ownership of the buffer.
+
+  @retval EFI_SUCCESS             The read request was queued if Token->Event
+                                  is not NULL. The data was read correctly
+                                  from the device if the Token->Event is NULL.
+  @retval EFI_DEVICE_ERROR        The device reported an error while attempting
+                                  to perform the read operation.
+  @retval EFI_NO_MEDIA            There is no media in the device.
+  @retval EFI_MEDIA_CHANGED       The MediaId is not for the current media.
+  @retval EFI_BAD_BUFFER_SIZE     The BufferSize parameter is not a multiple of
+                                  the intrinsic block size of the device.
+  @retval EFI_INVALID_PARAMETER   The read request contains LBAs that are not
+                                  valid, or the buffer is not on proper
+                                  alignment.
+  @retval EFI_OUT_OF_RESOURCES    The request could not be completed due to a
+                                  lack of resources.
+
+**/
+EFI_STATUS
+EFIAPI
+NvmeBlockIoReadBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN     UINT32                  MediaId,
+  IN     EFI_LBA                 Lba,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token,
+  IN     UINTN                   BufferSize,
+     OUT VOID                    *Buffer
+  );
+
+/**
+  Write BufferSize bytes from Buffer into Lba.
+
+  This function writes the requested number of blocks to the device. All blocks
+  are written, or an error is returned.
+  If there is no media in the device, the function returns EFI_NO_MEDIA. If the
+  MediaId is not the ID for the current media in the device, the function returns
+  EFI_MEDIA_CHANGED. The function must return EFI_NO_MEDIA or EFI_MEDIA_CHANGED
+  even if LBA, BufferSize, or Buffer are invalid so the caller can probe for
+  changes in media state.
+
+  @param[in]       This       Indicates a pointer to the calling context.
+  @param[in]       MediaId    The media ID that the write request is for.
+  @param[in]       Lba        The starting logical block address to be written.
+                              The caller is responsible for writing to only
+                              legitimate locations.
+  @param[in, out]  Token      A pointer to the token associated with the
+                              transaction.
+  @param[in]       BufferSize The size in bytes of Buffer. This must be a multiple
+                              of the intrinsic block size of the device.
+  @param[in]       Buffer     A pointer to the source buffer for the data.
+                              The caller is responsible for either having
+                              implicit or explicit ownership of the buffer.
+
+  @retval EFI_SUCCESS             The write request was queued if Token->Event
+                                  is not NULL. The data was written correctly
+                                  to the device if the Token->Event is NULL.
+  @retval EFI_DEVICE_ERROR        The device reported an error while attempting
+                                  to perform the write operation.
+  @retval EFI_NO_MEDIA            There is no media in the device.
+  @retval EFI_MEDIA_CHANGED       The MediaId is not for the current media.
+  @retval EFI_BAD_BUFFER_SIZE     The BufferSize parameter is not a multiple of
+                                  the intrinsic block size of the device.
+  @retval EFI_INVALID_PARAMETER   The write request contains LBAs that are not
+                                  valid, or the buffer is not on proper
+                                  alignment.
+  @retval EFI_OUT_OF_RESOURCES    The request could not be completed due to a
+                                  lack of resources.
+
+**/
+EFI_STATUS
+EFIAPI
+NvmeBlockIoWriteBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN     UINT32                  MediaId,
+  IN     EFI_LBA                 Lba,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token,
+  IN     UINTN                   BufferSize,
+  IN     VOID                    *Buffer
+  );
+
+/**
+  Flush the Block Device.
+
+  If EFI_DEVICE_ERROR, EFI_NO_MEDIA, EFI_WRITE_PROTECTED or EFI_MEDIA_CHANGED
+  is returned and non-blocking I/O is being used, the Event associated with
+  this request will not be signaled.
+
+  @param[in]      This     Indicates a pointer to the calling context.
+  @param[in,out]  Token    A pointer to the token associated with the
+                           transaction.
+
+  @retval EFI_SUCCESS          The flush request was queued if Event is not
+                               NULL. All outstanding data was written
+                               correctly to the device if the Event is NULL.
+  @retval EFI_DEVICE_ERROR     The device reported an error while writting back
+                               the data.
+  @retval EFI_WRITE_PROTECTED  The device cannot be written to.
+  @retval EFI_NO_MEDIA         There is no media in the device.
+  @retval EFI_MEDIA_CHANGED    The MediaId is not for the current media.
+  @retval EFI_OUT_OF_RESOURCES The request could not be completed due to a lack
+                               of resources.
+
+**/
+EFI_STATUS
+EFIAPI
+NvmeBlockIoFlushBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL   *This,
+  IN OUT EFI_BLOCK_IO2_TOKEN      *Token
+  );
+
+/**
+  Wait for the non-blocking requests of the controller, or of one of its
+  namespaces, to complete.
+
+  The requests are completed by the asynchronous task timer, which runs at
+  TPL_NOTIFY, so this must be called below TPL_NOTIFY.
+
+  @param  Private                The pointer to the NVME_CONTROLLER_PRIVATE_DATA data structure.
+  @param  Device                 The pointer to the NVME_DEVICE_PRIVATE_DATA data structure
+                                 of the namespace to wait for, or NULL to wait for all the
+                                 requests of the controller.
+
+  @retval EFI_SUCCESS            All the non-blocking requests are completed.
+  @retval EFI_TIMEOUT            The requests are not completed within
+                                 NVME_GENERIC_TIMEOUT.
+
+**/
+EFI_STATUS
+NvmeWaitAsyncQueueEmpty (
+  IN NVME_CONTROLLER_PRIVATE_DATA       *Private,
+  IN NVME_DEVICE_PRIVATE_DATA           *Device    OPTIONAL
+  );
+
 /**
   Send a security protocol command to a device that receives data and/or the result
   of one or more commands sent by SendData.
@@ -667,6 +667,8 @@ NvmeIdentifyNamespace (
   Create io completion queue.
 
   @param  Private          The pointer to the NVME_CONTROLLER_PRIVATE_DATA data structure.
+  @param  QueueId          The I/O queue ID to create.
+  @param  QueueSize        The number of entries of the queue, which is 0-based.
 
   @return EFI_SUCCESS      Successfully create io completion queue.
   @return EFI_DEVICE_ERROR Fail to create io completion queue.
@@ -674,7 +676,9 @@ NvmeIdentifyNamespace (
 **/
 EFI_STATUS
 NvmeCreateIoCompletionQueue (
-  IN NVME_CONTROLLER_PRIVATE_DATA      *Private
+  IN NVME_CONTROLLER_PRIVATE_DATA      *Private,
+  IN UINT16                            QueueId,
+  IN UINT16                            QueueSize
   )
 {
   EFI_NVM_EXPRESS_PASS_THRU_COMMAND_PACKET CommandPacket;
@@ -692,13 +696,13 @@ NvmeCreateIoCompletionQueue (
   CommandPacket.NvmeCompletion = &Completion;
 
   Command.Cdw0.Opcode = NVME_ADMIN_CRIOCQ_CMD;
-  CommandPacket.TransferBuffer = Private->CqBufferPciAddr[1];
+  CommandPacket.TransferBuffer = Private->CqBufferPciAddr[QueueId];
   CommandPacket.TransferLength = EFI_PAGE_SIZE;
   CommandPacket.CommandTimeout = NVME_GENERIC_TIMEOUT;
   CommandPacket.QueueType      = NVME_ADMIN_QUEUE;
 
-  CrIoCq.Qid   = NVME_IO_QUEUE;
-  CrIoCq.Qsize = NVME_CCQ_SIZE;
+  CrIoCq.Qid   = QueueId;
+  CrIoCq.Qsize = QueueSize;
   CrIoCq.Pc    = 1;
   CopyMem (&CommandPacket.NvmeCmd->Cdw10, &CrIoCq, sizeof (NVME_ADMIN_CRIOCQ));
   CommandPacket.NvmeCmd->Flags = CDW10_VALID | CDW11_VALID;
@@ -717,6 +721,8 @@ NvmeCreateIoCompletionQueue (
   Create io submission queue.
 
   @param  Private          The pointer to the NVME_CONTROLLER_PRIVATE_DATA data structure.
+  @param  QueueId          The I/O queue ID to create.
+  @param  QueueSize        The number of entries of the queue, which is 0-based.
 
   @return EFI_SUCCESS      Successfully create io submission queue.
   @return EFI_DEVICE_ERROR Fail to create io submission queue.
@@ -724,7 +730,9 @@ NvmeCreateIoCompletionQueue (
 **/
 EFI_STATUS
 NvmeCreateIoSubmissionQueue (
-  IN NVME_CONTROLLER_PRIVATE_DATA      *Private
+  IN NVME_CONTROLLER_PRIVATE_DATA      *Private,
+  IN UINT16                            QueueId,
+  IN UINT16                            QueueSize
   )
 {
   EFI_NVM_EXPRESS_PASS_THRU_COMMAND_PACKET CommandPacket;
@@ -742,15 +750,15 @@ NvmeCreateIoSubmissionQueue (
   CommandPacket.NvmeCompletion = &Completion;
 
   Command.Cdw0.Opcode = NVME_ADMIN_CRIOSQ_CMD;
-  CommandPacket.TransferBuffer = Private->SqBufferPciAddr[1];
+  CommandPacket.TransferBuffer = Private->SqBufferPciAddr[QueueId];
   CommandPacket.TransferLength = EFI_PAGE_SIZE;
   CommandPacket.CommandTimeout = NVME_GENERIC_TIMEOUT;
   CommandPacket.QueueType      = NVME_ADMIN_QUEUE;
 
-  CrIoSq.Qid   = NVME_IO_QUEUE;
-  CrIoSq.Qsize = NVME_CSQ_SIZE;
+  CrIoSq.Qid   = QueueId;
+  CrIoSq.Qsize = QueueSize;
   CrIoSq.Pc    = 1;
-  CrIoSq.Cqid  = NVME_IO_QUEUE;
+  CrIoSq.Cqid  = QueueId;
   CrIoSq.Qprio = 0;
   CopyMem (&CommandPacket.NvmeCmd->Cdw10, &CrIoSq, sizeof (NVME_ADMIN_CRIOSQ));
   CommandPacket.NvmeCmd->Flags = CDW10_VALID | CDW11_VALID;
@@ -841,15 +849,28 @@ NvmeControllerInit (
   //
   ASSERT ((Private->Cap.Mpsmin + 12) <= EFI_PAGE_SHIFT);
 
-  Private->Cid[0] = 0;
-  Private->Cid[1] = 0;
-
   Status = NvmeDisableController (Private);
 
   if (EFI_ERROR(Status)) {
     return Status;
   }
 
+  //
+  // Reset the queue indices and clear the queues left over from a previous
+  // initialization, so stale phase tags are not taken as new completions.
+  //
+  ZeroMem (Private->Buffer, EFI_PAGES_TO_SIZE (6));
+  ZeroMem (Private->SqTdbl, sizeof (Private->SqTdbl));
+  ZeroMem (Private->CqHdbl, sizeof (Private->CqHdbl));
+  ZeroMem (Private->Pt, sizeof (Private->Pt));
+  ZeroMem (Private->Cid, sizeof (Private->Cid));
+  Private->AsyncSqHead = 0;
+
+  //
+  // The asynchronous I/O queue may not exceed the maximum queue entries supported.
+  //
+  Private->AsyncQueueSize = (UINT16) MIN (NVME_ASYNC_CSQ_SIZE, Private->Cap.Mqes);
+
   //
   // set number of entries admin submission & completion queues.
   //
@@ -879,6 +900,10 @@ NvmeControllerInit (
   Private->SqBufferPciAddr[1] = (NVME_SQ *)(UINTN)(Private->BufferPciAddr + 2 * EFI_PAGE_SIZE);
   Private->CqBuffer[1]        = (NVME_CQ *)(UINTN)(Private->Buffer + 3 * EFI_PAGE_SIZE);
   Private->CqBufferPciAddr[1] = (NVME_CQ *)(UINTN)(Private->BufferPciAddr + 3 * EFI_PAGE_SIZE);
+  Private->SqBuffer[2]        = (NVME_SQ *)(UINTN)(Private->Buffer + 4 * EFI_PAGE_SIZE);
+  Private->SqBufferPciAddr[2] = (NVME_SQ *)(UINTN)(Private->BufferPciAddr + 4 * EFI_PAGE_SIZE);
+  Private->CqBuffer[2]        = (NVME_CQ *)(UINTN)(Private->Buffer + 5 * EFI_PAGE_SIZE);
+  Private->CqBufferPciAddr[2] = (NVME_CQ *)(UINTN)(Private->BufferPciAddr + 5 * EFI_PAGE_SIZE);
 
   DEBUG ((EFI_D_INFO, "Private->Buffer = [%016X]\n", (UINT64)(UINTN)Private->Buffer));
   DEBUG ((EFI_D_INFO, "Admin Submission Queue size (Aqa.Asqs) = [%08X]\n", Aqa.Asqs));
@@ -887,6 +912,9 @@ NvmeControllerInit (
   DEBUG ((EFI_D_INFO, "Admin Completion Queue (CqBuffer[0]) = [%016X]\n", Private->CqBuffer[0]));
   DEBUG ((EFI_D_INFO, "I/O   Submission Queue (SqBuffer[1]) = [%016X]\n", Private->SqBuffer[1]));
   DEBUG ((EFI_D_INFO, "I/O   Completion Queue (CqBuffer[1]) = [%016X]\n", Private->CqBuffer[1]));
+  DEBUG ((EFI_D_INFO, "I/O   Submission Queue (SqBuffer[2]) = [%016X]\n", Private->SqBuffer[2]));
+  DEBUG ((EFI_D_INFO, "I/O   Completion Queue (CqBuffer[2]) = [%016X]\n", Private->CqBuffer[2]));
+  DEBUG ((EFI_D_INFO, "Async I/O Queue size (0-based) = [%04X]\n", Private->AsyncQueueSize));
 
   //
   // Program admin queue attributes.
@@ -959,17 +987,27 @@ NvmeControllerInit (
   DEBUG ((EFI_D_INFO, "    NN        : 0x%x\n", Private->ControllerData->Nn));
 
   //
-  // Create one I/O completion queue.
+  // Create the I/O completion & submission queue pair #1 for blocking I/O.
   //
-  Status = NvmeCreateIoCompletionQueue (Private);
+  Status = NvmeCreateIoCompletionQueue (Private, 1, NVME_CCQ_SIZE);
+  if (EFI_ERROR(Status)) {
+   return Status;
+  }
+
+  Status = NvmeCreateIoSubmissionQueue (Private, 1, NVME_CSQ_SIZE);
   if (EFI_ERROR(Status)) {
    return Status;
   }
 
   //
-  // Create one I/O Submission queue.
+  // Create the I/O completion & submission queue pair #2 for non-blocking I/O.
   //
-  Status = NvmeCreateIoSubmissionQueue (Private);
+  Status = NvmeCreateIoCompletionQueue (Private, 2, Private->AsyncQueueSize);
+  if (EFI_ERROR(Status)) {
+   return Status;
+  }
+
+  Status = NvmeCreateIoSubmissionQueue (Private, 2, Private->AsyncQueueSize);
   if (EFI_ERROR(Status)) {
    return Status;
   }
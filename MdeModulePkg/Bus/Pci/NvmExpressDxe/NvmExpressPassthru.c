@@ -282,7 +282,7 @@ NvmeCreatePrpList (
   //
   ZeroMem (*PrpListHost, Bytes);
   for (PrpListIndex = 0; PrpListIndex < *PrpListNo - 1; ++PrpListIndex) {
-    PrpListBase = *(UINT64*)PrpListHost + PrpListIndex * EFI_PAGE_SIZE;
+    PrpListBase = (UINT64)(UINTN)*PrpListHost + PrpListIndex * EFI_PAGE_SIZE;
 
     for (PrpEntryIndex = 0; PrpEntryIndex < PrpEntryNo; ++PrpEntryIndex) {
       if (PrpEntryIndex != PrpEntryNo - 1) {
@@ -302,7 +302,7 @@ NvmeCreatePrpList (
   //
   // Fill last PRP list.
   //
-  PrpListBase = *(UINT64*)PrpListHost + PrpListIndex * EFI_PAGE_SIZE;
+  PrpListBase = (UINT64)(UINTN)*PrpListHost + PrpListIndex * EFI_PAGE_SIZE;
   for (PrpEntryIndex = 0; PrpEntryIndex < Remainder; ++PrpEntryIndex) {
     *((UINT64*)(UINTN)PrpListBase + PrpEntryIndex) = PhysicalAddr;
     PhysicalAddr += EFI_PAGE_SIZE;
@@ -376,6 +376,9 @@ NvmExpressPassThru (
   VOID                          *PrpListHost;
   UINTN                         PrpListNo;
   UINT32                        Data;
+  UINT16                        QueueId;
+  EFI_TPL                       OldTpl;
+  NVME_PASS_THRU_ASYNC_REQ      *AsyncRequest;
 
   //
   // check the data fields in Packet parameter.
@@ -392,29 +395,64 @@ NvmExpressPassThru (
     return EFI_INVALID_PARAMETER;
   }
 
-  Private     = NVME_CONTROLLER_PRIVATE_DATA_FROM_PASS_THRU (This);
-  PciIo       = Private->PciIo;
-  MapData     = NULL;
-  MapMeta     = NULL;
-  MapPrpList  = NULL;
-  PrpListHost = NULL;
-  PrpListNo   = 0;
-  Prp         = NULL;
-  TimerEvent  = NULL;
-  Status      = EFI_SUCCESS;
-
-  QueueType = Packet->QueueType;
-  Sq  = Private->SqBuffer[QueueType] + Private->SqTdbl[QueueType].Sqt;
-  Cq  = Private->CqBuffer[QueueType] + Private->CqHdbl[QueueType].Cqh;
+  Private      = NVME_CONTROLLER_PRIVATE_DATA_FROM_PASS_THRU (This);
+  PciIo        = Private->PciIo;
+  MapData      = NULL;
+  MapMeta      = NULL;
+  MapPrpList   = NULL;
+  PrpListHost  = NULL;
+  PrpListNo    = 0;
+  Prp          = NULL;
+  TimerEvent   = NULL;
+  AsyncRequest = NULL;
+  Status       = EFI_SUCCESS;
 
   if (Packet->NvmeCmd->Nsid != NamespaceId) {
     return EFI_INVALID_PARAMETER;
   }
 
+  //
+  // Admin commands and blocking I/O commands go to queue #0 and queue #1, and
+  // are always completed before returning. Non-blocking I/O commands go to the
+  // deeper queue #2 and are completed by the asynchronous task timer.
+  //
+  QueueType = Packet->QueueType;
+  if (QueueType == NVME_ADMIN_QUEUE) {
+    QueueId = 0;
+  } else if (Event == NULL) {
+    QueueId = 1;
+  } else {
+    QueueId = 2;
+  }
+
+  OldTpl = TPL_APPLICATION;
+  if (QueueId == 2) {
+    AsyncRequest = AllocateZeroPool (sizeof (NVME_PASS_THRU_ASYNC_REQ));
+    if (AsyncRequest == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    //
+    // Queue #2 is shared with the asynchronous task timer, so fill it at TPL_NOTIFY.
+    //
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+
+    //
+    // The submission queue is full if advancing the tail would reach the head.
+    //
+    if ((UINT16)((Private->SqTdbl[QueueId].Sqt + 1) % (Private->AsyncQueueSize + 1)) == Private->AsyncSqHead) {
+      Status = EFI_NOT_READY;
+      goto EXIT;
+    }
+  }
+
+  Sq  = Private->SqBuffer[QueueId] + Private->SqTdbl[QueueId].Sqt;
+  Cq  = Private->CqBuffer[QueueId] + Private->CqHdbl[QueueId].Cqh;
+
   ZeroMem (Sq, sizeof (NVME_SQ));
   Sq->Opc  = (UINT8)Packet->NvmeCmd->Cdw0.Opcode;
   Sq->Fuse = (UINT8)Packet->NvmeCmd->Cdw0.FusedOperation;
-  Sq->Cid  = Private->Cid[QueueType]++;
+  Sq->Cid  = Private->Cid[QueueId]++;
   Sq->Nsid = Packet->NvmeCmd->Nsid;
 
   //
@@ -423,7 +461,8 @@ NvmExpressPassThru (
   ASSERT (Sq->Psdt == 0);
   if (Sq->Psdt != 0) {
     DEBUG ((EFI_D_ERROR, "NvmExpressPassThru: doesn't support SGL mechanism\n"));
-    return EFI_UNSUPPORTED;
+    Status = EFI_UNSUPPORTED;
+    goto EXIT;
   }
 
   Sq->Prp[0] = (UINT64)(UINTN)Packet->TransferBuffer;
@@ -450,7 +489,9 @@ NvmExpressPassThru (
                       &MapData
                       );
     if (EFI_ERROR (Status) || (Packet->TransferLength != MapLength)) {
-      return EFI_OUT_OF_RESOURCES;
+      MapData = NULL;
+      Status  = EFI_OUT_OF_RESOURCES;
+      goto EXIT;
     }
 
     Sq->Prp[0] = PhyAddr;
@@ -468,12 +509,9 @@ NvmExpressPassThru (
                         &MapMeta
                         );
       if (EFI_ERROR (Status) || (Packet->MetadataLength != MapLength)) {
-        PciIo->Unmap (
-                 PciIo,
-                 MapData
-                 );
-
-        return EFI_OUT_OF_RESOURCES;
+        MapMeta = NULL;
+        Status  = EFI_OUT_OF_RESOURCES;
+        goto EXIT;
       }
       Sq->Mptr = PhyAddr;
     }
@@ -492,6 +530,8 @@ NvmExpressPassThru (
     PhyAddr = (Sq->Prp[0] + EFI_PAGE_SIZE) & ~(EFI_PAGE_SIZE - 1);
     Prp = NvmeCreatePrpList (PciIo, PhyAddr, EFI_SIZE_TO_PAGES(Offset + Bytes) - 1, &PrpListHost, &PrpListNo, &MapPrpList);
     if (Prp == NULL) {
+      MapPrpList = NULL;
+      Status     = EFI_OUT_OF_RESOURCES;
       goto EXIT;
     }
 
@@ -525,20 +565,52 @@ NvmExpressPassThru (
     Sq->Payload.Raw.Cdw15 = Packet->NvmeCmd->Cdw15;
   }
 
+  //
+  // For non-blocking requests, record the resources to be released once the
+  // command completes before handing the command to the controller.
+  //
+  if (QueueId == 2) {
+    AsyncRequest->Signature   = NVME_PASS_THRU_ASYNC_REQ_SIG;
+    AsyncRequest->Packet      = Packet;
+    AsyncRequest->CommandId   = Sq->Cid;
+    AsyncRequest->CallerEvent = Event;
+    AsyncRequest->Timeout     = Packet->CommandTimeout;
+    AsyncRequest->MapData     = MapData;
+    AsyncRequest->MapMeta     = MapMeta;
+    AsyncRequest->MapPrpList  = MapPrpList;
+    AsyncRequest->PrpListNo   = PrpListNo;
+    AsyncRequest->PrpListHost = (Prp != NULL) ? PrpListHost : NULL;
+    InsertTailList (&Private->AsyncPassThruQueue, &AsyncRequest->Link);
+  }
+
   //
   // Ring the submission queue doorbell.
   //
-  Private->SqTdbl[QueueType].Sqt ^= 1;
-  Data = ReadUnaligned32 ((UINT32*)&Private->SqTdbl[QueueType]);
+  if (QueueId == 2) {
+    Private->SqTdbl[QueueId].Sqt =
+      (UINT16)((Private->SqTdbl[QueueId].Sqt + 1) % (Private->AsyncQueueSize + 1));
+  } else {
+    Private->SqTdbl[QueueId].Sqt ^= 1;
+  }
+  Data = ReadUnaligned32 ((UINT32*)&Private->SqTdbl[QueueId]);
   PciIo->Mem.Write (
                PciIo,
                EfiPciIoWidthUint32,
                NVME_BAR,
-               NVME_SQTDBL_OFFSET(QueueType, Private->Cap.Dstrd),
+               NVME_SQTDBL_OFFSET(QueueId, Private->Cap.Dstrd),
                1,
                &Data
                );
 
+  //
+  // For non-blocking requests, return directly. The completion is reaped by
+  // the asynchronous task timer, which then signals the caller's event.
+  //
+  if (QueueId == 2) {
+    gBS->RestoreTPL (OldTpl);
+    return EFI_SUCCESS;
+  }
+
   Status = gBS->CreateEvent (
                   EVT_TIMER,
                   TPL_CALLBACK,
@@ -561,7 +633,7 @@ NvmExpressPassThru (
   //
   Status = EFI_TIMEOUT;
   while (EFI_ERROR (gBS->CheckEvent (TimerEvent))) {
-    if (Cq->Pt != Private->Pt[QueueType]) {
+    if (Cq->Pt != Private->Pt[QueueId]) {
       Status = EFI_SUCCESS;
       break;
     }
@@ -589,20 +661,27 @@ NvmExpressPassThru (
     }
   }
 
-  if ((Private->CqHdbl[QueueType].Cqh ^= 1) == 0) {
-    Private->Pt[QueueType] ^= 1;
+  if ((Private->CqHdbl[QueueId].Cqh ^= 1) == 0) {
+    Private->Pt[QueueId] ^= 1;
   }
 
-  Data = ReadUnaligned32 ((UINT32*)&Private->CqHdbl[QueueType]);
+  Data = ReadUnaligned32 ((UINT32*)&Private->CqHdbl[QueueId]);
   PciIo->Mem.Write (
                PciIo,
                EfiPciIoWidthUint32,
                NVME_BAR,
-               NVME_CQHDBL_OFFSET(QueueType, Private->Cap.Dstrd),
+               NVME_CQHDBL_OFFSET(QueueId, Private->Cap.Dstrd),
                1,
                &Data
                );
 
+  //
+  // Admin commands are always blocking, signal the caller's event if one is given.
+  //
+  if (Event != NULL) {
+    gBS->SignalEvent (Event);
+  }
+
 EXIT:
   if (MapData != NULL) {
     PciIo->Unmap (
@@ -632,6 +711,11 @@ EXIT:
   if (TimerEvent != NULL) {
     gBS->CloseEvent (TimerEvent);
   }
+
+  if (AsyncRequest != NULL) {
+    FreePool (AsyncRequest);
+    gBS->RestoreTPL (OldTpl);
+  }
   return Status;
 }
 
@@ -44,6 +44,8 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/DevicePathLib.h>
 #include <Library/PcdLib.h>
 #include <Library/PeCoffLib.h>
+#include <Library/PerformanceLib.h>
+#include <Library/PrintLib.h>
 
 #include <IndustryStandard/Pci.h>
 #include <IndustryStandard/PeImage.h>
@@ -55,6 +57,15 @@ typedef struct _PCI_BAR                    PCI_BAR;
 #define EFI_PCI_RID(Bus, Device, Function)  (((UINT32)Bus << 8) + ((UINT32)Device << 3) + (UINT32)Function)
 #define EFI_PCI_BUS_OF_RID(RID)             ((UINT32)RID >> 8)
 
+//
+// Performance log tokens of the per-function scan and option ROM load, the
+// module string being the "[Segment|Bus|Device|Function]" of the function.
+//
+#define PCI_PERF_SCAN_TOKEN                 "PciBus:Scan:"
+#define PCI_PERF_OPROM_TOKEN                "PciBus:OpRom:"
+#define PCI_PERF_MODULE_FORMAT              "[%04x|%02x|%02x|%02x]"
+#define PCI_PERF_MODULE_SIZE                20
+
 #define     EFI_PCI_IOV_POLICY_ARI           0x0001
 #define     EFI_PCI_IOV_POLICY_SRIOV         0x0002
 #define     EFI_PCI_IOV_POLICY_MRIOV         0x0004
@@ -329,6 +329,7 @@ ProcessOptionRom (
 {
   LIST_ENTRY      *CurrentLink;
   PCI_IO_DEVICE   *Temp;
+  CHAR8           PerfModule[PCI_PERF_MODULE_SIZE];
 
   //
   // Go through bridges to reach all devices
@@ -349,7 +350,22 @@ ProcessOptionRom (
       //
       // Load and process the option rom
       //
+      PERF_CODE (
+        AsciiSPrint (
+          PerfModule,
+          sizeof (PerfModule),
+          PCI_PERF_MODULE_FORMAT,
+          Temp->PciRootBridgeIo->SegmentNumber,
+          Temp->BusNumber,
+          Temp->DeviceNumber,
+          Temp->FunctionNumber
+          );
+        PERF_START (NULL, PCI_PERF_OPROM_TOKEN, PerfModule, 0);
+      );
       LoadOpRomImage (Temp, RomBase);
+      PERF_CODE (
+        PERF_END (NULL, PCI_PERF_OPROM_TOKEN, PerfModule, 0);
+      );
     }
 
     CurrentLink = CurrentLink->ForwardLink;
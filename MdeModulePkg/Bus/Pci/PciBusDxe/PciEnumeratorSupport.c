@@ -219,6 +219,7 @@ PciSearchDevice (
   )
 {
   PCI_IO_DEVICE *PciIoDevice;
+  CHAR8         PerfModule[PCI_PERF_MODULE_SIZE];
 
   PciIoDevice = NULL;
 
@@ -231,6 +232,19 @@ PciSearchDevice (
     Bus, Device, Func
     ));
 
+  PERF_CODE (
+    AsciiSPrint (
+      PerfModule,
+      sizeof (PerfModule),
+      PCI_PERF_MODULE_FORMAT,
+      Bridge->PciRootBridgeIo->SegmentNumber,
+      Bus,
+      Device,
+      Func
+      );
+    PERF_START (NULL, PCI_PERF_SCAN_TOKEN, PerfModule, 0);
+  );
+
   if (!IS_PCI_BRIDGE (Pci)) {
 
     if (IS_CARDBUS_BRIDGE (Pci)) {
@@ -281,6 +295,9 @@ PciSearchDevice (
   }
 
   if (PciIoDevice == NULL) {
+    PERF_CODE (
+      PERF_END (NULL, PCI_PERF_SCAN_TOKEN, PerfModule, 0);
+    );
     return EFI_OUT_OF_RESOURCES;
   }
 
@@ -290,6 +307,9 @@ PciSearchDevice (
   UpdatePciInfo (PciIoDevice);
 
   if (PciIoDevice->DevicePath == NULL) {
+    PERF_CODE (
+      PERF_END (NULL, PCI_PERF_SCAN_TOKEN, PerfModule, 0);
+    );
     return EFI_OUT_OF_RESOURCES;
   }
 
@@ -321,6 +341,9 @@ PciSearchDevice (
     *PciDevice = PciIoDevice;
   }
 
+  PERF_CODE (
+    PERF_END (NULL, PCI_PERF_SCAN_TOKEN, PerfModule, 0);
+  );
   return EFI_SUCCESS;
 }
 
@@ -1441,6 +1441,39 @@ ON_ERROR:
   return EFI_DEVICE_ERROR;
 }
 
+/**
+  Check whether the event ring holds events which have not been handled yet,
+  without touching the XHCI registers.
+
+  @param  Xhc                   The XHCI Instance.
+
+  @retval TRUE                  There are events to handle.
+  @retval FALSE                 The event ring is empty.
+
+**/
+BOOLEAN
+XhcHasPendingEvent (
+  IN USB_XHCI_INSTANCE    *Xhc
+  )
+{
+  EVENT_RING              *EvtRing;
+
+  EvtRing = &Xhc->EventRing;
+
+  //
+  // Events found by the last synchronization but not dequeued yet.
+  //
+  if (EvtRing->EventRingDequeue != EvtRing->EventRingEnqueue) {
+    return TRUE;
+  }
+
+  //
+  // Otherwise EventRingCCS is the cycle state expected at the dequeue pointer,
+  // so a new event is there only if the controller has written its cycle bit.
+  //
+  return (BOOLEAN) (EvtRing->EventRingDequeue->CycleBit == EvtRing->EventRingCCS);
+}
+
 /**
   Interrupt transfer periodic check handler.
 
@@ -1463,11 +1496,19 @@ XhcMonitorAsyncRequests (
   UINT8                   SlotId;
   EFI_STATUS              Status;
   EFI_TPL                 OldTpl;
+  BOOLEAN                 HcFailed;
 
   OldTpl = gBS->RaiseTPL (XHC_TPL);
 
   Xhc    = (USB_XHCI_INSTANCE*) Context;
 
+  if (IsListEmpty (&Xhc->AsyncIntTransfers)) {
+    gBS->RestoreTPL (OldTpl);
+    return;
+  }
+
+  HcFailed = (BOOLEAN) (XhcIsHalt (Xhc) || XhcIsSysError (Xhc));
+
   EFI_LIST_FOR_EACH_SAFE (Entry, Next, &Xhc->AsyncIntTransfers) {
     Urb = EFI_LIST_CONTAINER (Entry, URB, UrbList);
 
@@ -1483,7 +1524,14 @@ XhcMonitorAsyncRequests (
     // Check the result of URB execution. If it is still
     // active, check the next one.
     //
-    XhcCheckUrbResult (Xhc, Urb);
+    // The event ring is shared by all the URBs, and handling it updates every
+    // async URB it has events for. So once the ring is drained, the remaining
+    // active URBs cannot have progressed in this round, and the event ring and
+    // the XHCI registers are not read again for each of them.
+    //
+    if (!Urb->Finished && (HcFailed || XhcHasPendingEvent (Xhc))) {
+      XhcCheckUrbResult (Xhc, Urb);
+    }
 
     if (!Urb->Finished) {
       continue;
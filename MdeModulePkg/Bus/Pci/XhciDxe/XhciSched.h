@@ -1268,6 +1268,21 @@ XhcCheckNewEvent (
   OUT TRB_TEMPLATE            **NewEvtTrb
   );
 
+/**
+  Check whether the event ring holds events which have not been handled yet,
+  without touching the XHCI registers.
+
+  @param  Xhc                   The XHCI Instance.
+
+  @retval TRUE                  There are events to handle.
+  @retval FALSE                 The event ring is empty.
+
+**/
+BOOLEAN
+XhcHasPendingEvent (
+  IN USB_XHCI_INSTANCE    *Xhc
+  );
+
 /**
   Create XHCI transfer ring.
 
@@ -643,6 +643,7 @@ UsbFindChild (
 
   @param  HubIf                 The HUB that has the device connected.
   @param  Port                  The port index of the hub (started with zero).
+  @param  Debounced             TRUE if the connection has been debounced by UsbDebouncePorts.
 
   @retval EFI_SUCCESS           The device is enumerated (added or removed).
   @retval EFI_OUT_OF_RESOURCES  Failed to allocate resource for the device.
@@ -652,7 +653,8 @@ UsbFindChild (
 EFI_STATUS
 UsbEnumerateNewDev (
   IN USB_INTERFACE        *HubIf,
-  IN UINT8                Port
+  IN UINT8                Port,
+  IN BOOLEAN              Debounced
   )
 {
   USB_BUS                 *Bus;
@@ -669,7 +671,9 @@ UsbEnumerateNewDev (
   HubApi  = HubIf->HubApi;  
   Address = Bus->MaxDevices;
 
-  gBS->Stall (USB_WAIT_PORT_STABLE_STALL);
+  if (!Debounced) {
+    gBS->Stall (USB_WAIT_PORT_STABLE_STALL);
+  }
   
   //
   // Hub resets the device for at least 10 milliseconds.
@@ -862,6 +866,7 @@ ON_ERROR:
 
   @param  HubIf                 The HUB that has the device connected.
   @param  Port                  The port index of the hub (started with zero).
+  @param  Debounced             TRUE if the connection has been debounced by UsbDebouncePorts.
 
   @retval EFI_SUCCESS           The device is enumerated (added or removed).
   @retval EFI_OUT_OF_RESOURCES  Failed to allocate resource for the device.
@@ -871,13 +876,15 @@ ON_ERROR:
 EFI_STATUS
 UsbEnumeratePort (
   IN USB_INTERFACE        *HubIf,
-  IN UINT8                Port
+  IN UINT8                Port,
+  IN BOOLEAN              Debounced
   )
 {
   USB_HUB_API             *HubApi;
   USB_DEVICE              *Child;
   EFI_USB_PORT_STATUS     PortState;
   EFI_STATUS              Status;
+  CHAR8                   PerfModule[USB_PERF_MODULE_SIZE];
 
   Child   = NULL;
   HubApi  = HubIf->HubApi;
@@ -896,7 +903,7 @@ UsbEnumeratePort (
   // Only handle connection/enable/overcurrent/reset change.
   // Usb super speed hub may report other changes, such as warm reset change. Ignore them.
   //
-  if ((PortState.PortChangeStatus & (USB_PORT_STAT_C_CONNECTION | USB_PORT_STAT_C_ENABLE | USB_PORT_STAT_C_OVERCURRENT | USB_PORT_STAT_C_RESET)) == 0) {
+  if ((PortState.PortChangeStatus & USB_PORT_STAT_C_ENUMERATE) == 0) {
     return EFI_SUCCESS;
   }
 
@@ -964,7 +971,12 @@ UsbEnumeratePort (
     // Now, new device connected, enumerate and configure the device 
     //
     DEBUG (( EFI_D_INFO, "UsbEnumeratePort: new device connected at port %d\n", Port));
-    Status = UsbEnumerateNewDev (HubIf, Port);
+    PERF_CODE (
+      AsciiSPrint (PerfModule, sizeof (PerfModule), "[%02x|%02x]", HubIf->Device->Address, Port);
+      PERF_START (NULL, USB_PERF_ENUM_TOKEN, PerfModule, 0);
+    );
+    Status = UsbEnumerateNewDev (HubIf, Port, Debounced);
+    PERF_END (NULL, USB_PERF_ENUM_TOKEN, PerfModule, 0);
   
   } else {
     DEBUG (( EFI_D_INFO, "UsbEnumeratePort: device disconnected event on port %d\n", Port));
@@ -975,6 +987,54 @@ UsbEnumeratePort (
 }
 
 
+/**
+  Wait for the new connections on the hub ports to become stable.
+
+  The USB specification requires a debounce interval of at least 100ms after
+  the attach of a device, before its port is reset [USB20-9.1.2]. The interval
+  runs per port, so a single wait covers all the ports that reported a change
+  in the same round, instead of one wait per port. The reset and addressing
+  still happen one port at a time, since only one device at a time may answer
+  at the default address.
+
+  @param  HubIf                 The HUB interface.
+  @param  PortMap               On input, the ports to check. On output, the ports
+                                whose connection has been debounced.
+
+**/
+VOID
+UsbDebouncePorts (
+  IN     USB_INTERFACE        *HubIf,
+  IN OUT UINT8                *PortMap
+  )
+{
+  EFI_USB_PORT_STATUS     PortState;
+  EFI_STATUS              Status;
+  UINT8                   Index;
+  BOOLEAN                 Connected;
+
+  Connected = FALSE;
+
+  for (Index = 0; Index < HubIf->NumOfPort; Index++) {
+    if (!USB_PORT_MAP_IS_SET (PortMap, Index)) {
+      continue;
+    }
+
+    Status = HubIf->HubApi->GetPortStatus (HubIf, Index, &PortState);
+    if (EFI_ERROR (Status) ||
+        ((PortState.PortChangeStatus & USB_PORT_STAT_C_ENUMERATE) == 0) ||
+        !USB_BIT_IS_SET (PortState.PortStatus, USB_PORT_STAT_CONNECTION)) {
+      USB_PORT_MAP_CLEAR (PortMap, Index);
+    } else {
+      Connected = TRUE;
+    }
+  }
+
+  if (Connected) {
+    gBS->Stall (USB_WAIT_PORT_STABLE_STALL);
+  }
+}
+
 /**
   Enumerate all the changed hub ports.
 
@@ -994,6 +1054,7 @@ UsbHubEnumeration (
   UINT8                   Bit;
   UINT8                   Index;
   USB_DEVICE              *Child;
+  UINT8                   PortMap[USB_PORT_MAP_SIZE];
   
   ASSERT (Context != NULL);
 
@@ -1014,12 +1075,26 @@ UsbHubEnumeration (
   //
   // HUB starts its port index with 1.
   //
+  ZeroMem (PortMap, sizeof (PortMap));
+  Byte  = 0;
+  Bit   = 1;
+
+  for (Index = 0; Index < HubIf->NumOfPort; Index++) {
+    if (USB_BIT_IS_SET (HubIf->ChangeMap[Byte], USB_BIT (Bit))) {
+      USB_PORT_MAP_SET (PortMap, Index);
+    }
+
+    USB_NEXT_BIT (Byte, Bit);
+  }
+
+  UsbDebouncePorts (HubIf, PortMap);
+
   Byte  = 0;
   Bit   = 1;
 
   for (Index = 0; Index < HubIf->NumOfPort; Index++) {
     if (USB_BIT_IS_SET (HubIf->ChangeMap[Byte], USB_BIT (Bit))) {
-      UsbEnumeratePort (HubIf, Index);
+      UsbEnumeratePort (HubIf, Index, USB_PORT_MAP_IS_SET (PortMap, Index));
     }
 
     USB_NEXT_BIT (Byte, Bit);
@@ -1050,6 +1125,7 @@ UsbRootHubEnumeration (
   USB_INTERFACE           *RootHub;
   UINT8                   Index;
   USB_DEVICE              *Child;
+  UINT8                   PortMap[USB_PORT_MAP_SIZE];
 
   RootHub = (USB_INTERFACE *) Context;
 
@@ -1059,7 +1135,12 @@ UsbRootHubEnumeration (
       DEBUG (( EFI_D_INFO, "UsbEnumeratePort: The device disconnect fails at port %d from root hub %p, try again\n", Index, RootHub));
       UsbRemoveDevice (Child);
     }
-    
-    UsbEnumeratePort (RootHub, Index);
+  }
+
+  SetMem (PortMap, sizeof (PortMap), 0xFF);
+  UsbDebouncePorts (RootHub, PortMap);
+
+  for (Index = 0; Index < RootHub->NumOfPort; Index++) {
+    UsbEnumeratePort (RootHub, Index, USB_PORT_MAP_IS_SET (PortMap, Index));
   }
 }
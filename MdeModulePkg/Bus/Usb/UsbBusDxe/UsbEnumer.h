@@ -28,6 +28,27 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
             }                 \
           } while (0)
 
+//
+// Bitmap of hub ports, bit N for port N (started with zero). A hub has at most 255 ports.
+//
+#define USB_PORT_MAP_SIZE               32
+#define USB_PORT_MAP_SET(Map, Port)     ((Map)[(Port) >> 3] |= (UINT8) USB_BIT ((Port) & 7))
+#define USB_PORT_MAP_CLEAR(Map, Port)   ((Map)[(Port) >> 3] &= (UINT8) ~USB_BIT ((Port) & 7))
+#define USB_PORT_MAP_IS_SET(Map, Port)  USB_BIT_IS_SET ((Map)[(Port) >> 3], USB_BIT ((Port) & 7))
+
+//
+// Port changes that cause the device on the port to be enumerated again.
+//
+#define USB_PORT_STAT_C_ENUMERATE       (USB_PORT_STAT_C_CONNECTION | USB_PORT_STAT_C_ENABLE | \
+                                         USB_PORT_STAT_C_OVERCURRENT | USB_PORT_STAT_C_RESET)
+
+//
+// Performance log token of the device enumeration, the module string
+// being the "[HubAddress|Port]" of the device.
+//
+#define USB_PERF_ENUM_TOKEN             "UsbBus:Enum:"
+#define USB_PERF_MODULE_SIZE            12
+
 
 //
 // Common interface used by usb bus enumeration process.
@@ -188,6 +188,7 @@ struct _USB_MASS_DEVICE {
   EFI_DISK_INFO_PROTOCOL    DiskInfo;
   USB_BOOT_INQUIRY_DATA     InquiryData;
   BOOLEAN                   Cdb16Byte;
+  UINT32                    MaxCarrySize; ///< 0 indicates USB_BOOT_IO_BLOCKS blocks per command
 };
 
 #endif
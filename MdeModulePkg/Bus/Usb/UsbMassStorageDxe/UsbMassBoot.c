@@ -765,6 +765,76 @@ ON_ERROR:
 }
 
 
+/**
+  Get the max carried size of the READ/WRITE commands for the USB mass storage
+  interface, according to the max packet size of its bulk IN endpoint.
+
+  @param  UsbIo                  The USB IO protocol of the interface.
+
+  @return The max carried size in bytes, or 0 to carry USB_BOOT_IO_BLOCKS blocks.
+
+**/
+UINT32
+UsbBootGetMaxCarrySize (
+  IN  EFI_USB_IO_PROTOCOL   *UsbIo
+  )
+{
+  EFI_USB_INTERFACE_DESCRIPTOR  Interface;
+  EFI_USB_ENDPOINT_DESCRIPTOR   EndPoint;
+  EFI_STATUS                    Status;
+  UINT8                         Index;
+
+  Status = UsbIo->UsbGetInterfaceDescriptor (UsbIo, &Interface);
+  if (EFI_ERROR (Status)) {
+    return 0;
+  }
+
+  for (Index = 0; Index < Interface.NumEndpoints; Index++) {
+    Status = UsbIo->UsbGetEndpointDescriptor (UsbIo, Index, &EndPoint);
+
+    if (EFI_ERROR (Status) || !USB_IS_BULK_ENDPOINT (EndPoint.Attributes) ||
+        !USB_IS_IN_ENDPOINT (EndPoint.EndpointAddress)) {
+      continue;
+    }
+
+    //
+    // Only SuperSpeed bulk endpoints have a max packet size of 1024 bytes.
+    //
+    if (EndPoint.MaxPacketSize >= 1024) {
+      return USB_BOOT_MAX_CARRY_SIZE_SS;
+    }
+    break;
+  }
+
+  return 0;
+}
+
+/**
+  Get the max number of blocks carried by one READ/WRITE command.
+
+  @param  UsbMass                The USB mass storage device.
+
+  @return The max number of blocks, which fits in the 16 bit transfer length.
+
+**/
+UINTN
+UsbBootGetMaxIoBlocks (
+  IN  USB_MASS_DEVICE       *UsbMass
+  )
+{
+  UINT32                    BlockSize;
+  UINTN                     MaxIoBlocks;
+
+  BlockSize   = UsbMass->BlockIoMedia.BlockSize;
+  MaxIoBlocks = USB_BOOT_IO_BLOCKS;
+
+  if ((BlockSize != 0) && (UsbMass->MaxCarrySize / BlockSize > MaxIoBlocks)) {
+    MaxIoBlocks = MIN (UsbMass->MaxCarrySize / BlockSize, MAX_UINT16);
+  }
+
+  return MaxIoBlocks;
+}
+
 /**
   Read some blocks from the device.
 
@@ -801,7 +871,7 @@ UsbBootReadBlocks (
     // on the device. We must split the total block because the READ10
     // command only has 16 bit transfer length (in the unit of block).
     //
-    Count     = (UINT16)((TotalBlock < USB_BOOT_IO_BLOCKS) ? TotalBlock : USB_BOOT_IO_BLOCKS);
+    Count     = (UINT16) MIN (TotalBlock, UsbBootGetMaxIoBlocks (UsbMass));
     ByteSize  = (UINT32)Count * BlockSize;
 
     //
@@ -877,7 +947,7 @@ UsbBootWriteBlocks (
     // on the device. We must split the total block because the WRITE10
     // command only has 16 bit transfer length (in the unit of block).
     //
-    Count     = (UINT16)((TotalBlock < USB_BOOT_IO_BLOCKS) ? TotalBlock : USB_BOOT_IO_BLOCKS);
+    Count     = (UINT16) MIN (TotalBlock, UsbBootGetMaxIoBlocks (UsbMass));
     ByteSize  = (UINT32)Count * BlockSize;
 
     //
@@ -951,7 +1021,7 @@ UsbBootReadBlocks16 (
     //
     // Split the total blocks into smaller pieces.
     //
-    Count     = (UINT16)((TotalBlock < USB_BOOT_IO_BLOCKS) ? TotalBlock : USB_BOOT_IO_BLOCKS);
+    Count     = (UINT16) MIN (TotalBlock, UsbBootGetMaxIoBlocks (UsbMass));
     ByteSize  = (UINT32)Count * BlockSize;
 
     //
@@ -1025,7 +1095,7 @@ UsbBootWriteBlocks16 (
     //
     // Split the total blocks into smaller pieces.
     //
-    Count     = (UINT16)((TotalBlock < USB_BOOT_IO_BLOCKS) ? TotalBlock : USB_BOOT_IO_BLOCKS);
+    Count     = (UINT16) MIN (TotalBlock, UsbBootGetMaxIoBlocks (UsbMass));
     ByteSize  = (UINT32)Count * BlockSize;
 
     //
@@ -68,6 +68,13 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 //
 #define USB_BOOT_IO_BLOCKS              128
 
+//
+// Max carried size of SuperSpeed devices, which are only attached to XHCI.
+// XHCI splits a transfer into 64KB TRBs, so larger commands only save the
+// per-command CBW/CSW round trips and keep the device streaming.
+//
+#define USB_BOOT_MAX_CARRY_SIZE_SS      SIZE_1MB
+
 //
 // Retry mass command times, set by experience
 //
@@ -270,6 +277,33 @@ UsbBootDetectMedia (
   IN  USB_MASS_DEVICE       *UsbMass
   );
 
+/**
+  Get the max carried size of the READ/WRITE commands for the USB mass storage
+  interface, according to the max packet size of its bulk IN endpoint.
+
+  @param  UsbIo                  The USB IO protocol of the interface.
+
+  @return The max carried size in bytes, or 0 to carry USB_BOOT_IO_BLOCKS blocks.
+
+**/
+UINT32
+UsbBootGetMaxCarrySize (
+  IN  EFI_USB_IO_PROTOCOL   *UsbIo
+  );
+
+/**
+  Get the max number of blocks carried by one READ/WRITE command.
+
+  @param  UsbMass                The USB mass storage device.
+
+  @return The max number of blocks, which fits in the 16 bit transfer length.
+
+**/
+UINTN
+UsbBootGetMaxIoBlocks (
+  IN  USB_MASS_DEVICE       *UsbMass
+  );
+
 /**
   Read some blocks from the device.
 
@@ -506,6 +506,7 @@ UsbMassInitMultiLun (
     UsbMass->Transport            = Transport;
     UsbMass->Context              = Context;
     UsbMass->Lun                  = Index;
+    UsbMass->MaxCarrySize         = UsbBootGetMaxCarrySize (UsbIo);
     
     //
     // Initialize the media parameter data for EFI_BLOCK_IO_MEDIA of Block I/O Protocol.
@@ -646,6 +647,7 @@ UsbMassInitNonLun (
   UsbMass->OpticalStorage       = FALSE;
   UsbMass->Transport            = Transport;
   UsbMass->Context              = Context;
+  UsbMass->MaxCarrySize         = UsbBootGetMaxCarrySize (UsbIo);
   
   //
   // Initialize the media parameter data for EFI_BLOCK_IO_MEDIA of Block I/O Protocol.
@@ -21,7 +21,12 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
 #include <Uefi.h>
 
-UINT32  mCrcTable[256];
+//
+// Slicing-by-8 tables. mCrcTable[0] is the classic byte-wise table, and
+// mCrcTable[N][Byte] is the CRC of Byte followed by N zero bytes, so eight
+// input bytes can be folded into the CRC with eight independent lookups.
+//
+UINT32  mCrcTable[8][256];
 
 /**
   Calculate CRC32 for target data.
@@ -44,7 +49,8 @@ RuntimeDriverCalculateCrc32 (
   )
 {
   UINT32  Crc;
-  UINTN   Index;
+  UINT32  Low;
+  UINT32  High;
   UINT8   *Ptr;
 
   if (Data == NULL || DataSize == 0 || CrcOut == NULL) {
@@ -52,8 +58,36 @@ RuntimeDriverCalculateCrc32 (
   }
 
   Crc = 0xffffffff;
-  for (Index = 0, Ptr = Data; Index < DataSize; Index++, Ptr++) {
-    Crc = (Crc >> 8) ^ mCrcTable[(UINT8) Crc ^ *Ptr];
+  Ptr = Data;
+
+  //
+  // Process the leading bytes one at a time until the data is 32-bit aligned.
+  //
+  while ((DataSize > 0) && (((UINTN) Ptr & (sizeof (UINT32) - 1)) != 0)) {
+    Crc = (Crc >> 8) ^ mCrcTable[0][(UINT8) Crc ^ *Ptr];
+    Ptr++;
+    DataSize--;
+  }
+
+  //
+  // Process 8 bytes per iteration. All the supported processors are little endian,
+  // so the first byte of the data is the least significant byte of Low.
+  //
+  while (DataSize >= 8) {
+    Low  = *(UINT32 *) Ptr ^ Crc;
+    High = *(UINT32 *) (Ptr + 4);
+    Crc  = mCrcTable[7][(UINT8) Low]         ^ mCrcTable[6][(UINT8) (Low >> 8)]  ^
+           mCrcTable[5][(UINT8) (Low >> 16)] ^ mCrcTable[4][(UINT8) (Low >> 24)] ^
+           mCrcTable[3][(UINT8) High]        ^ mCrcTable[2][(UINT8) (High >> 8)] ^
+           mCrcTable[1][(UINT8) (High >> 16)] ^ mCrcTable[0][(UINT8) (High >> 24)];
+    Ptr      += 8;
+    DataSize -= 8;
+  }
+
+  while (DataSize > 0) {
+    Crc = (Crc >> 8) ^ mCrcTable[0][(UINT8) Crc ^ *Ptr];
+    Ptr++;
+    DataSize--;
   }
 
   *CrcOut = Crc ^ 0xffffffff;
@@ -110,6 +144,14 @@ RuntimeDriverInitializeCrc32Table (
       }
     }
 
-    mCrcTable[TableEntry] = ReverseBits (Value);
+    mCrcTable[0][TableEntry] = ReverseBits (Value);
+  }
+
+  for (TableEntry = 0; TableEntry < 256; TableEntry++) {
+    Value = mCrcTable[0][TableEntry];
+    for (Index = 1; Index < 8; Index++) {
+      Value = (Value >> 8) ^ mCrcTable[0][(UINT8) Value];
+      mCrcTable[Index][TableEntry] = Value;
+    }
   }
 }
@@ -16,6 +16,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <IndustryStandard/Bmp.h>
 #include <Protocol/GraphicsOutput.h>
 #include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/DebugLib.h>
 #include <Library/ImageDecoderLib.h>
@@ -59,9 +60,9 @@ BmpImageDecoderLibConvertBmpToGopBlt (
   UINTN                         Index;
   UINTN                         Height;
   UINTN                         Width;
-  UINTN                         ImageIndex;
   UINT32                        DataSizePerLine;
   UINT32                        ColorMapNum;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL Palette[256];
 
   ASSERT ((GopBlt != NULL) && (GopBltSize != NULL));
 
@@ -109,6 +110,27 @@ BmpImageDecoderLibConvertBmpToGopBlt (
     return EFI_INVALID_PARAMETER;
   }
 
+  //
+  // Only 1, 4, 8, 24 and 32 bit BMP images are supported.
+  //
+  switch (BmpHeader->BitPerPixel) {
+  case 1:
+    ColorMapNum = 2;
+    break;
+  case 4:
+    ColorMapNum = 16;
+    break;
+  case 8:
+    ColorMapNum = 256;
+    break;
+  case 24:
+  case 32:
+    ColorMapNum = 0;
+    break;
+  default:
+    return EFI_UNSUPPORTED;
+  }
+
   //
   // Calculate Color Map offset in the image.
   //
@@ -119,20 +141,6 @@ BmpImageDecoderLibConvertBmpToGopBlt (
   }
 
   if (BmpHeader->ImageOffset > sizeof (BMP_IMAGE_HEADER)) {
-    switch (BmpHeader->BitPerPixel) {
-      case 1:
-        ColorMapNum = 2;
-        break;
-      case 4:
-        ColorMapNum = 16;
-        break;
-      case 8:
-        ColorMapNum = 256;
-        break;
-      default:
-        ColorMapNum = 0;
-        break;
-      }
     //
     // BMP file may has padding data between the bmp header section and the bmp data section.
     //
@@ -141,11 +149,23 @@ BmpImageDecoderLibConvertBmpToGopBlt (
     }
   }
 
+  //
+  // Convert the color map to Blt pixels once, so that every pixel of the image
+  // is converted by copying a Blt pixel. Colors beyond the end of the file are
+  // black.
+  //
+  ZeroMem (Palette, sizeof (Palette));
+  ColorMapNum = MIN (ColorMapNum, (UINT32) ((BmpImageSize - sizeof (BMP_IMAGE_HEADER)) / sizeof (BMP_COLOR_MAP)));
+  for (Index = 0; Index < ColorMapNum; Index++) {
+    Palette[Index].Blue  = BmpColorMap[Index].Blue;
+    Palette[Index].Green = BmpColorMap[Index].Green;
+    Palette[Index].Red   = BmpColorMap[Index].Red;
+  }
+
   //
   // Calculate graphics image data address in the image
   //
-  Image         = ((UINT8 *) BmpImage) + BmpHeader->ImageOffset;
-  ImageHeader   = Image;
+  ImageHeader   = ((UINT8 *) BmpImage) + BmpHeader->ImageOffset;
 
   //
   // Calculate the BltBuffer needed size.
@@ -169,81 +189,57 @@ BmpImageDecoderLibConvertBmpToGopBlt (
   *PixelHeight  = BmpHeader->PixelHeight;
 
   //
-  // Convert image from BMP to Blt buffer format
+  // Convert image from BMP to Blt buffer format one row at a time. The rows
+  // are stored bottom up, each one starting on a 32-bit boundary.
   //
   BltBuffer = *GopBlt;
   for (Height = 0; Height < BmpHeader->PixelHeight; Height++) {
-    Blt = &BltBuffer[(BmpHeader->PixelHeight - Height - 1) * BmpHeader->PixelWidth];
-    for (Width = 0; Width < BmpHeader->PixelWidth; Width++, Image++, Blt++) {
-      switch (BmpHeader->BitPerPixel) {
-      case 1:
-        //
-        // Convert 1-bit (2 colors) BMP to 24-bit color
-        //
-        for (Index = 0; Index < 8 && Width < BmpHeader->PixelWidth; Index++) {
-          Blt->Red    = BmpColorMap[((*Image) >> (7 - Index)) & 0x1].Red;
-          Blt->Green  = BmpColorMap[((*Image) >> (7 - Index)) & 0x1].Green;
-          Blt->Blue   = BmpColorMap[((*Image) >> (7 - Index)) & 0x1].Blue;
-          Blt++;
-          Width++;
-        }
-
-        Blt--;
-        Width--;
-        break;
-
-      case 4:
-        //
-        // Convert 4-bit (16 colors) BMP Palette to 24-bit color
-        //
-        Index       = (*Image) >> 4;
-        Blt->Red    = BmpColorMap[Index].Red;
-        Blt->Green  = BmpColorMap[Index].Green;
-        Blt->Blue   = BmpColorMap[Index].Blue;
-        if (Width < (BmpHeader->PixelWidth - 1)) {
-          Blt++;
-          Width++;
-          Index       = (*Image) & 0x0f;
-          Blt->Red    = BmpColorMap[Index].Red;
-          Blt->Green  = BmpColorMap[Index].Green;
-          Blt->Blue   = BmpColorMap[Index].Blue;
-        }
-        break;
-
-      case 8:
-        //
-        // Convert 8-bit (256 colors) BMP Palette to 24-bit color
-        //
-        Blt->Red    = BmpColorMap[*Image].Red;
-        Blt->Green  = BmpColorMap[*Image].Green;
-        Blt->Blue   = BmpColorMap[*Image].Blue;
-        break;
-
-      case 24:
-        //
-        // It is 24-bit BMP.
-        //
-        Blt->Blue   = *Image++;
-        Blt->Green  = *Image++;
-        Blt->Red    = *Image;
-        break;
-
-      default:
-        //
-        // Other bit format BMP is not supported.
-        //
-        return EFI_UNSUPPORTED;
-        break;
-      };
+    Image = ImageHeader + Height * DataSizePerLine;
+    Blt   = &BltBuffer[(BmpHeader->PixelHeight - Height - 1) * BmpHeader->PixelWidth];
 
-    }
+    switch (BmpHeader->BitPerPixel) {
+    case 1:
+      //
+      // Convert 1-bit (2 colors) BMP to 24-bit color
+      //
+      for (Width = 0; Width < BmpHeader->PixelWidth; Width++) {
+        Blt[Width] = Palette[(Image[Width >> 3] >> (7 - (Width & 0x7))) & 0x1];
+      }
+      break;
+
+    case 4:
+      //
+      // Convert 4-bit (16 colors) BMP Palette to 24-bit color
+      //
+      for (Width = 0; Width < BmpHeader->PixelWidth; Width++) {
+        Blt[Width] = Palette[(Image[Width >> 1] >> (((Width & 0x1) == 0) ? 4 : 0)) & 0x0f];
+      }
+      break;
+
+    case 8:
+      //
+      // Convert 8-bit (256 colors) BMP Palette to 24-bit color
+      //
+      for (Width = 0; Width < BmpHeader->PixelWidth; Width++) {
+        Blt[Width] = Palette[Image[Width]];
+      }
+      break;
+
+    case 24:
+      //
+      // It is 24-bit BMP. Each pixel is stored as one 32-bit write.
+      //
+      for (Width = 0; Width < BmpHeader->PixelWidth; Width++, Image += 3) {
+        *(UINT32 *) &Blt[Width] = (UINT32) Image[0] | ((UINT32) Image[1] << 8) | ((UINT32) Image[2] << 16);
+      }
+      break;
 
-    ImageIndex = (UINTN) (Image - ImageHeader);
-    if ((ImageIndex % 4) != 0) {
+    default:
       //
-      // Bmp Image starts each row on a 32-bit boundary!
+      // It is 32-bit BMP, which has the layout of the Blt buffer.
       //
-      Image = Image + (4 - (ImageIndex % 4));
+      CopyMem (Blt, Image, BmpHeader->PixelWidth * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+      break;
     }
   }
 
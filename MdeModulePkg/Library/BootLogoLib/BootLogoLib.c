@@ -29,6 +29,16 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/DebugLib.h>
 #include <Library/ImageDecoderLib.h>
 
+//
+// The last logo decoded from a FV file. Showing it again, after the consoles
+// are reconnected for instance, neither reads the FV file nor decodes it again.
+//
+EFI_GUID                      mLogoCacheFile;
+EFI_GRAPHICS_OUTPUT_BLT_PIXEL *mLogoCacheBlt = NULL;
+UINTN                         mLogoCacheBltSize;
+UINTN                         mLogoCacheWidth;
+UINTN                         mLogoCacheHeight;
+
 /**
   Show LOGO on all consoles.
 
@@ -169,7 +179,7 @@ BootLogoEnableLogo (
         break;
       }
 
-    } else {
+    } else if ((mLogoCacheBlt == NULL) || !CompareGuid (Logo, &mLogoCacheFile)) {
       //
       // Get the specified image from FV.
       //
@@ -181,10 +191,35 @@ BootLogoEnableLogo (
 
     if (Blt != NULL) {
       FreePool (Blt);
+      Blt = NULL;
     }
 
-    Status = DecodeImage (ImageFormat, ImageData, ImageSize, &Blt, &BltSize, &Width, &Height);
-    FreePool (ImageData);
+    if (ImageData == NULL) {
+      //
+      // The image is decoded already.
+      //
+      Blt     = AllocateCopyPool (mLogoCacheBltSize, mLogoCacheBlt);
+      BltSize = mLogoCacheBltSize;
+      Width   = mLogoCacheWidth;
+      Height  = mLogoCacheHeight;
+      Status  = (Blt == NULL) ? EFI_OUT_OF_RESOURCES : EFI_SUCCESS;
+    } else {
+      Status = DecodeImage (ImageFormat, ImageData, ImageSize, &Blt, &BltSize, &Width, &Height);
+      FreePool (ImageData);
+
+      if (!EFI_ERROR (Status) && (PlatformLogo == NULL)) {
+        if (mLogoCacheBlt != NULL) {
+          FreePool (mLogoCacheBlt);
+        }
+        mLogoCacheBlt = AllocateCopyPool (BltSize, Blt);
+        if (mLogoCacheBlt != NULL) {
+          CopyGuid (&mLogoCacheFile, Logo);
+          mLogoCacheBltSize = BltSize;
+          mLogoCacheWidth   = Width;
+          mLogoCacheHeight  = Height;
+        }
+      }
+    }
     if (EFI_ERROR (Status)) {
       if (Logo != NULL) {
         //
@@ -1657,10 +1657,41 @@ NetblockChecksum (
   IN UINT32                 Len
   )
 {
-  register UINT32           Sum;
+  register UINT64           Sum;
+  UINT32                    *Bulk32;
 
   Sum = 0;
 
+  //
+  // The one's complement sum doesn't depend on the word size, so sum
+  // aligned 32-bit words into a 64-bit accumulator when possible. It
+  // can't overflow for any length a UINT32 holds. Odd aligned data
+  // is summed 16 bits at a time as before.
+  //
+  if (((UINTN) Bulk & 0x01) == 0) {
+    if ((((UINTN) Bulk & 0x02) != 0) && (Len > 1)) {
+      Sum += *(UINT16 *) Bulk;
+      Bulk += 2;
+      Len -= 2;
+    }
+
+    Bulk32 = (UINT32 *) Bulk;
+
+    while (Len >= 16) {
+      Sum += (UINT64) Bulk32[0] + Bulk32[1] + (UINT64) Bulk32[2] + Bulk32[3];
+      Bulk32 += 4;
+      Len -= 16;
+    }
+
+    while (Len >= 4) {
+      Sum += *Bulk32;
+      Bulk32++;
+      Len -= 4;
+    }
+
+    Bulk = (UINT8 *) Bulk32;
+  }
+
   while (Len > 1) {
     Sum += *(UINT16 *) Bulk;
     Bulk += 2;
@@ -1675,11 +1706,12 @@ NetblockChecksum (
   }
 
   //
-  // Fold 32-bit sum to 16 bits
+  // Fold 64-bit sum to 16 bits
   //
-  while ((Sum >> 16) != 0) {
-    Sum = (Sum & 0xffff) + (Sum >> 16);
+  Sum = (Sum & 0xffffffff) + RShiftU64 (Sum, 32);
 
+  while (RShiftU64 (Sum, 16) != 0) {
+    Sum = (Sum & 0xffff) + RShiftU64 (Sum, 16);
   }
 
   return (UINT16) Sum;
@@ -382,6 +382,13 @@ ConSplitterDriverEntry(
   ASSERT (FeaturePcdGet (PcdConOutGopSupport) ||
           FeaturePcdGet (PcdConOutUgaSupport));
 
+  if (FeaturePcdGet (PcdConOutQueueEnable)) {
+    //
+    // Without the events, the text only devices are written synchronously.
+    //
+    OutputQueueInitialize ();
+  }
+
   //
   // The driver creates virtual handles for ConIn, ConOut, StdErr.
   // The virtual handles will always exist even if no console exist in the
@@ -3017,6 +3024,15 @@ ConSplitterTextOutAddDevice (
   TextAndGop->TextOut        = TextOut;
   TextAndGop->GraphicsOutput = GraphicsOutput;
   TextAndGop->UgaDraw        = UgaDraw;
+  TextAndGop->OutputQueue    = NULL;
+
+  if (FeaturePcdGet (PcdConOutQueueEnable) && (GraphicsOutput == NULL) && (UgaDraw == NULL)) {
+    //
+    // Text only devices, like serial terminals, are written from a queue so
+    // that the other devices do not wait for them.
+    //
+    TextAndGop->OutputQueue = OutputQueueAttach (TextOut);
+  }
 
   if (CurrentNumOfConsoles == 0) {
     //
@@ -3186,6 +3202,9 @@ ConSplitterTextOutDeleteDevice (
       if (TextOutList->GraphicsOutput != NULL) {
         Private->CurrentNumberOfGraphicsOutput--;
       }
+      if (TextOutList->OutputQueue != NULL) {
+        OutputQueueDetach (TextOutList->OutputQueue);
+      }
       CopyMem (TextOutList, TextOutList + 1, sizeof (TEXT_OUT_AND_GOP_DATA) * Index);
       CurrentNumOfConsoles--;
       break;
@@ -4215,6 +4234,8 @@ ConSplitterTextOutReset (
 
   Private = TEXT_OUT_SPLITTER_PRIVATE_DATA_FROM_THIS (This);
 
+  OutputQueueFlush (Private);
+
   //
   // return the worst status met
   //
@@ -4271,31 +4292,47 @@ ConSplitterTextOutOutputString (
   EFI_STATUS                      ReturnStatus;
   UINTN                           MaxColumn;
   UINTN                           MaxRow;
+  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL *SyncTextOut;
 
   This->SetAttribute (This, This->Mode->Attribute);
 
   Private         = TEXT_OUT_SPLITTER_PRIVATE_DATA_FROM_THIS (This);
+  SyncTextOut     = NULL;
 
   //
   // return the worst status met
   //
   for (Index = 0, ReturnStatus = EFI_SUCCESS; Index < Private->CurrentNumberOfConsoles; Index++) {
-    Status = Private->TextOutList[Index].TextOut->OutputString (
-                                                    Private->TextOutList[Index].TextOut,
-                                                    WString
-                                                    );
+    if (Private->TextOutList[Index].OutputQueue != NULL) {
+      Status = OutputQueueAdd (
+                 Private->TextOutList[Index].OutputQueue,
+                 OutputQueueOutputString,
+                 0,
+                 0,
+                 WString
+                 );
+    } else {
+      Status = Private->TextOutList[Index].TextOut->OutputString (
+                                                      Private->TextOutList[Index].TextOut,
+                                                      WString
+                                                      );
+      if (SyncTextOut == NULL) {
+        SyncTextOut = Private->TextOutList[Index].TextOut;
+      }
+    }
     if (EFI_ERROR (Status)) {
       ReturnStatus = Status;
     }
   }
 
-  if (Private->CurrentNumberOfConsoles > 0) {
-    Private->TextOutMode.CursorColumn = Private->TextOutList[0].TextOut->Mode->CursorColumn;
-    Private->TextOutMode.CursorRow    = Private->TextOutList[0].TextOut->Mode->CursorRow;
+  if (SyncTextOut != NULL) {
+    Private->TextOutMode.CursorColumn = SyncTextOut->Mode->CursorColumn;
+    Private->TextOutMode.CursorRow    = SyncTextOut->Mode->CursorRow;
   } else {
     //
-    // When there is no real console devices in system, 
-    // update cursor position for the virtual device in consplitter.
+    // When there is no real console devices in system, or they are all
+    // written from output queues, update cursor position for the virtual
+    // device in consplitter.
     //
     Private->TextOut.QueryMode (
                        &Private->TextOut,
@@ -4502,6 +4539,8 @@ ConSplitterTextOutSetMode (
   if (Private->TextOutMode.Mode == (INT32) ModeNumber) {
     return ConSplitterTextOutClearScreen (This);
   }
+  OutputQueueFlush (Private);
+
   //
   // return the worst status met
   //
@@ -4567,10 +4606,14 @@ ConSplitterTextOutSetAttribute (
   // return the worst status met
   //
   for (Index = 0, ReturnStatus = EFI_SUCCESS; Index < Private->CurrentNumberOfConsoles; Index++) {
-    Status = Private->TextOutList[Index].TextOut->SetAttribute (
-                                                    Private->TextOutList[Index].TextOut,
-                                                    Attribute
-                                                    );
+    if (Private->TextOutList[Index].OutputQueue != NULL) {
+      Status = OutputQueueAdd (Private->TextOutList[Index].OutputQueue, OutputQueueSetAttribute, Attribute, 0, NULL);
+    } else {
+      Status = Private->TextOutList[Index].TextOut->SetAttribute (
+                                                      Private->TextOutList[Index].TextOut,
+                                                      Attribute
+                                                      );
+    }
     if (EFI_ERROR (Status)) {
       ReturnStatus = Status;
     }
@@ -4611,7 +4654,11 @@ ConSplitterTextOutClearScreen (
   // return the worst status met
   //
   for (Index = 0, ReturnStatus = EFI_SUCCESS; Index < Private->CurrentNumberOfConsoles; Index++) {
-    Status = Private->TextOutList[Index].TextOut->ClearScreen (Private->TextOutList[Index].TextOut);
+    if (Private->TextOutList[Index].OutputQueue != NULL) {
+      Status = OutputQueueAdd (Private->TextOutList[Index].OutputQueue, OutputQueueClearScreen, 0, 0, NULL);
+    } else {
+      Status = Private->TextOutList[Index].TextOut->ClearScreen (Private->TextOutList[Index].TextOut);
+    }
     if (EFI_ERROR (Status)) {
       ReturnStatus = Status;
     }
@@ -4620,7 +4667,8 @@ ConSplitterTextOutClearScreen (
   //
   // No need to do extra check here as whether (Column, Row) is valid has
   // been checked in ConSplitterTextOutSetCursorPosition. And (0, 0) should
-  // always be supported.
+  // always be supported. The modes of the devices written from output queues
+  // catch up when their requests are sent.
   //
   Private->TextOutMode.CursorColumn = 0;
   Private->TextOutMode.CursorRow    = 0;
@@ -4691,11 +4739,15 @@ ConSplitterTextOutSetCursorPosition (
   // return the worst status met
   //
   for (Index = 0, ReturnStatus = EFI_SUCCESS; Index < Private->CurrentNumberOfConsoles; Index++) {
-    Status = Private->TextOutList[Index].TextOut->SetCursorPosition (
-                                                    Private->TextOutList[Index].TextOut,
-                                                    Column,
-                                                    Row
-                                                    );
+    if (Private->TextOutList[Index].OutputQueue != NULL) {
+      Status = OutputQueueAdd (Private->TextOutList[Index].OutputQueue, OutputQueueSetCursorPosition, Column, Row, NULL);
+    } else {
+      Status = Private->TextOutList[Index].TextOut->SetCursorPosition (
+                                                      Private->TextOutList[Index].TextOut,
+                                                      Column,
+                                                      Row
+                                                      );
+    }
     if (EFI_ERROR (Status)) {
       ReturnStatus = Status;
     }
@@ -4704,7 +4756,8 @@ ConSplitterTextOutSetCursorPosition (
   //
   // No need to do extra check here as whether (Column, Row) is valid has
   // been checked in ConSplitterTextOutSetCursorPosition. And (0, 0) should
-  // always be supported.
+  // always be supported. The modes of the devices written from output queues
+  // catch up when their requests are sent.
   //
   Private->TextOutMode.CursorColumn = (INT32) Column;
   Private->TextOutMode.CursorRow    = (INT32) Row;
@@ -4745,10 +4798,14 @@ ConSplitterTextOutEnableCursor (
   // return the worst status met
   //
   for (Index = 0, ReturnStatus = EFI_SUCCESS; Index < Private->CurrentNumberOfConsoles; Index++) {
-    Status = Private->TextOutList[Index].TextOut->EnableCursor (
-                                                    Private->TextOutList[Index].TextOut,
-                                                    Visible
-                                                    );
+    if (Private->TextOutList[Index].OutputQueue != NULL) {
+      Status = OutputQueueAdd (Private->TextOutList[Index].OutputQueue, OutputQueueEnableCursor, Visible, 0, NULL);
+    } else {
+      Status = Private->TextOutList[Index].TextOut->EnableCursor (
+                                                      Private->TextOutList[Index].TextOut,
+                                                      Visible
+                                                      );
+    }
     if (EFI_ERROR (Status)) {
       ReturnStatus = Status;
     }
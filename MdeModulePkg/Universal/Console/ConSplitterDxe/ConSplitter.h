@@ -33,6 +33,8 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Guid/StandardErrorDevice.h>
 #include <Guid/ConsoleOutDevice.h>
 #include <Guid/ConnectConInEvent.h>
+#include <Guid/EventGroup.h>
+#include <Guid/IdleLoopEvent.h>
 
 #include <Library/PcdLib.h>
 #include <Library/DebugLib.h>
@@ -178,10 +180,53 @@ typedef struct {
 
 #define TEXT_OUT_SPLITTER_PRIVATE_DATA_SIGNATURE  SIGNATURE_32 ('T', 'o', 'S', 'p')
 
+//
+// Output queue of a text only console device, drained from a timer event and
+// from the idle loop so that the other consoles do not wait for it.
+//
+#define OUTPUT_QUEUE_SIGNATURE          SIGNATURE_32 ('O', 'u', 'Q', 'u')
+#define OUTPUT_QUEUE_DEPTH              64
+#define OUTPUT_QUEUE_STRING_LENGTH      80
+#define OUTPUT_QUEUE_DRAIN_COUNT        4
+#define OUTPUT_QUEUE_TIMER_PERIOD       100000
+
+typedef enum {
+  OutputQueueOutputString,
+  OutputQueueSetAttribute,
+  OutputQueueClearScreen,
+  OutputQueueSetCursorPosition,
+  OutputQueueEnableCursor
+} OUTPUT_QUEUE_REQUEST_TYPE;
+
+typedef struct {
+  OUTPUT_QUEUE_REQUEST_TYPE        Type;
+  UINTN                            Argument[2];
+  UINTN                            Length;
+  CHAR16                           String[OUTPUT_QUEUE_STRING_LENGTH + 1];
+} OUTPUT_QUEUE_REQUEST;
+
+typedef struct {
+  UINTN                            Signature;
+  LIST_ENTRY                       Link;
+  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL  *TextOut;
+  UINTN                            ReferenceCount;
+  UINTN                            InUse;
+  BOOLEAN                          FreePending;
+  BOOLEAN                          Draining;
+  UINTN                            Dropped;
+  EFI_STATUS                       Status;
+  UINTN                            Head;
+  UINTN                            Count;
+  OUTPUT_QUEUE_REQUEST             Request[OUTPUT_QUEUE_DEPTH];
+} OUTPUT_QUEUE;
+
+#define OUTPUT_QUEUE_FROM_LINK(a)  CR (a, OUTPUT_QUEUE, Link, OUTPUT_QUEUE_SIGNATURE)
+
 typedef struct {
   EFI_GRAPHICS_OUTPUT_PROTOCOL     *GraphicsOutput;
   EFI_UGA_DRAW_PROTOCOL            *UgaDraw;
   EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL  *TextOut;
+  OUTPUT_QUEUE                     *OutputQueue;
 } TEXT_OUT_AND_GOP_DATA;
 
 //
@@ -2000,5 +2045,100 @@ ConSplitterEmptyCallbackFunction (
   IN VOID                     *Context
   );
 
+//
+// Output queue functions
+//
+
+/**
+  Create the events draining the output queues, and flushing them when
+  ExitBootServices() is called.
+
+  @retval EFI_SUCCESS              The events are created.
+  @retval Others                   The events cannot be created.
+
+**/
+EFI_STATUS
+OutputQueueInitialize (
+  VOID
+  );
+
+/**
+  Get the output queue of a text output device, creating it if it is not
+  shared with the other splitter yet.
+
+  @param  TextOut                  Simple Text Output protocol pointer.
+
+  @return The output queue, or NULL if the device is written synchronously.
+
+**/
+OUTPUT_QUEUE *
+OutputQueueAttach (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL    *TextOut
+  );
+
+/**
+  Flush the output queue of a text output device that is removed from a
+  splitter, and free it when no splitter uses it any more.
+
+  If the removal interrupted a caller draining the queue or adding to it, the
+  queue is freed when that caller is done with it.
+
+  @param  Queue                    The output queue.
+
+**/
+VOID
+OutputQueueDetach (
+  IN  OUTPUT_QUEUE                       *Queue
+  );
+
+/**
+  Add a request to the output queue of a text output device. If the queue is
+  full, the oldest requests are sent to the device first. A SetAttribute
+  request that does not change the attribute is dropped, so that it does not
+  split the strings output with the same attribute.
+
+  @param  Queue                    The output queue.
+  @param  Type                     The type of the request.
+  @param  Argument0                The first argument of the request.
+  @param  Argument1                The second argument of the request.
+  @param  String                   The string to output for an
+                                   OutputQueueOutputString request.
+
+  @retval EFI_SUCCESS              The request is queued.
+  @retval EFI_DEVICE_ERROR         The device reported an error for an earlier
+                                   request.
+
+**/
+EFI_STATUS
+OutputQueueAdd (
+  IN  OUTPUT_QUEUE                       *Queue,
+  IN  OUTPUT_QUEUE_REQUEST_TYPE          Type,
+  IN  UINTN                              Argument0,
+  IN  UINTN                              Argument1,
+  IN  CHAR16                             *String     OPTIONAL
+  );
+
+/**
+  Send all queued requests to the text output devices of a splitter.
+
+  @param  Private                  Text Out Splitter pointer.
+
+**/
+VOID
+OutputQueueFlush (
+  IN  TEXT_OUT_SPLITTER_PRIVATE_DATA     *Private
+  );
+
+/**
+  Send all queued requests to all text output devices. It is called before
+  ExitBootServices() completes, and may be called whenever all output needs
+  to have reached the devices.
+
+**/
+VOID
+OutputQueueFlushAll (
+  VOID
+  );
+
 
 #endif
@@ -0,0 +1,617 @@
+/** @file
+  Output queues of the text only console devices.
+
+  Writing to a serial terminal takes much longer than drawing on a graphics
+  console, and the console splitter writes to the devices one after the other.
+  The requests for a text only console device are therefore queued, and sent
+  to the device from a timer event and from the idle loop, in the order they
+  were made. A queue holds a bounded number of requests; when it is full, the
+  oldest requests are sent to the device by the caller.
+
+  The mode of the splitter is updated when a request is made, while the mode
+  of a queued device, such as its cursor position, only catches up when the
+  request is sent. The mode of the splitter is the one the callers see.
+
+  The timer event only runs while some request is queued.
+
+Copyright (c) 2016, Intel Corporation. All rights reserved.<BR>
+This program and the accompanying materials
+are licensed and made available under the terms and conditions of the BSD License
+which accompanies this distribution.  The full text of the license may be found at
+http://opensource.org/licenses/bsd-license.php
+
+THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#include "ConSplitter.h"
+
+//
+// The output queues, shared by ConOut and StdErr when both use a device.
+//
+LIST_ENTRY  mOutputQueueList = INITIALIZE_LIST_HEAD_VARIABLE (mOutputQueueList);
+
+//
+// The requests are sent to the devices as soon as they are made once the
+// queues are flushed for ExitBootServices().
+//
+BOOLEAN     mOutputQueueEnabled = FALSE;
+
+EFI_EVENT   mOutputQueueTimerEvent;
+BOOLEAN     mOutputQueueTimerActive = FALSE;
+EFI_EVENT   mOutputQueueIdleEvent;
+EFI_EVENT   mOutputQueueExitBootServicesEvent;
+
+/**
+  Send a request to the device.
+
+  @param  TextOut                  Simple Text Output protocol pointer.
+  @param  Request                  The request.
+
+  @return The status returned by the device.
+
+**/
+EFI_STATUS
+OutputQueueSendRequest (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL    *TextOut,
+  IN  OUTPUT_QUEUE_REQUEST               *Request
+  )
+{
+  switch (Request->Type) {
+  case OutputQueueOutputString:
+    return TextOut->OutputString (TextOut, Request->String);
+
+  case OutputQueueSetAttribute:
+    return TextOut->SetAttribute (TextOut, Request->Argument[0]);
+
+  case OutputQueueClearScreen:
+    return TextOut->ClearScreen (TextOut);
+
+  case OutputQueueSetCursorPosition:
+    return TextOut->SetCursorPosition (TextOut, Request->Argument[0], Request->Argument[1]);
+
+  case OutputQueueEnableCursor:
+    return TextOut->EnableCursor (TextOut, (BOOLEAN) Request->Argument[0]);
+
+  default:
+    ASSERT (FALSE);
+    return EFI_UNSUPPORTED;
+  }
+}
+
+/**
+  Keep an output queue from being freed until the caller releases it.
+
+  @param  Queue                    The output queue.
+
+**/
+VOID
+OutputQueueAcquire (
+  IN  OUTPUT_QUEUE                       *Queue
+  )
+{
+  EFI_TPL                         OldTpl;
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  Queue->InUse++;
+  gBS->RestoreTPL (OldTpl);
+}
+
+/**
+  Release an output queue kept by the caller, and free it if it was detached
+  from the splitters meanwhile.
+
+  @param  Queue                    The output queue.
+
+**/
+VOID
+OutputQueueRelease (
+  IN  OUTPUT_QUEUE                       *Queue
+  )
+{
+  EFI_TPL                         OldTpl;
+  BOOLEAN                         Free;
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  ASSERT (Queue->InUse > 0);
+  Queue->InUse--;
+  Free = (BOOLEAN) ((Queue->InUse == 0) && Queue->FreePending);
+  gBS->RestoreTPL (OldTpl);
+
+  if (Free) {
+    FreePool (Queue);
+  }
+}
+
+/**
+  Send the oldest requests of an output queue to the device.
+
+  The request being sent stays at the head of the queue until the device
+  returns, so that a request made meanwhile is not merged into it. If the
+  queue is already being drained by an interrupted caller, nothing is done.
+
+  @param  Queue                    The output queue.
+  @param  MaxCount                 The maximum number of requests to send.
+
+**/
+VOID
+OutputQueueDrain (
+  IN  OUTPUT_QUEUE                       *Queue,
+  IN  UINTN                              MaxCount
+  )
+{
+  EFI_TPL                         OldTpl;
+  OUTPUT_QUEUE_REQUEST            *Request;
+  EFI_STATUS                      Status;
+
+  OutputQueueAcquire (Queue);
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  if (Queue->Draining) {
+    gBS->RestoreTPL (OldTpl);
+    OutputQueueRelease (Queue);
+    return;
+  }
+  Queue->Draining = TRUE;
+  gBS->RestoreTPL (OldTpl);
+
+  while (MaxCount > 0) {
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+    if (Queue->Count == 0) {
+      gBS->RestoreTPL (OldTpl);
+      break;
+    }
+    Request = &Queue->Request[Queue->Head];
+    gBS->RestoreTPL (OldTpl);
+
+    Status = OutputQueueSendRequest (Queue->TextOut, Request);
+
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+    //
+    // The splitter checked the arguments against the shared mode already,
+    // so only the failures of the device are reported to later callers.
+    //
+    if (EFI_ERROR (Status) && (Status != EFI_UNSUPPORTED)) {
+      Queue->Status = EFI_DEVICE_ERROR;
+    }
+    Queue->Head = (Queue->Head + 1) % OUTPUT_QUEUE_DEPTH;
+    Queue->Count--;
+    gBS->RestoreTPL (OldTpl);
+
+    MaxCount--;
+  }
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  Queue->Draining = FALSE;
+  gBS->RestoreTPL (OldTpl);
+
+  OutputQueueRelease (Queue);
+}
+
+/**
+  Start the timer event draining the output queues, if it is not running.
+  It is called at TPL_NOTIFY when a request is queued.
+
+**/
+VOID
+OutputQueueStartTimer (
+  VOID
+  )
+{
+  EFI_STATUS                      Status;
+
+  if (!mOutputQueueTimerActive) {
+    Status = gBS->SetTimer (mOutputQueueTimerEvent, TimerPeriodic, OUTPUT_QUEUE_TIMER_PERIOD);
+    mOutputQueueTimerActive = (BOOLEAN) !EFI_ERROR (Status);
+  }
+}
+
+/**
+  Send a few requests of every output queue to its device, and stop the timer
+  event once all the queues are empty.
+
+  @param  Event                    The timer or idle loop event.
+  @param  Context                  Not used.
+
+**/
+VOID
+EFIAPI
+OutputQueueNotify (
+  IN  EFI_EVENT                          Event,
+  IN  VOID                               *Context
+  )
+{
+  LIST_ENTRY                      *Link;
+  OUTPUT_QUEUE                    *Queue;
+  EFI_TPL                         OldTpl;
+  BOOLEAN                         Empty;
+
+  for (Link = GetFirstNode (&mOutputQueueList); !IsNull (&mOutputQueueList, Link); Link = GetNextNode (&mOutputQueueList, Link)) {
+    OutputQueueDrain (OUTPUT_QUEUE_FROM_LINK (Link), OUTPUT_QUEUE_DRAIN_COUNT);
+  }
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  Empty  = TRUE;
+  for (Link = GetFirstNode (&mOutputQueueList); !IsNull (&mOutputQueueList, Link); Link = GetNextNode (&mOutputQueueList, Link)) {
+    Queue = OUTPUT_QUEUE_FROM_LINK (Link);
+    if (Queue->Count != 0) {
+      Empty = FALSE;
+      break;
+    }
+  }
+  if (Empty && mOutputQueueTimerActive) {
+    gBS->SetTimer (mOutputQueueTimerEvent, TimerCancel, 0);
+    mOutputQueueTimerActive = FALSE;
+  }
+  gBS->RestoreTPL (OldTpl);
+}
+
+/**
+  Send all queued requests to the devices before ExitBootServices() completes,
+  and send the later requests directly.
+
+  The memory map is terminated before this event is signaled, so the events
+  draining the queues are not closed here; they are not signaled any more.
+
+  @param  Event                    The ExitBootServices event.
+  @param  Context                  Not used.
+
+**/
+VOID
+EFIAPI
+OutputQueueExitBootServicesNotify (
+  IN  EFI_EVENT                          Event,
+  IN  VOID                               *Context
+  )
+{
+  OutputQueueFlushAll ();
+  mOutputQueueEnabled = FALSE;
+}
+
+/**
+  Create the events draining the output queues, and flushing them when
+  ExitBootServices() is called. The timer event is started by the first
+  queued request.
+
+  @retval EFI_SUCCESS              The events are created.
+  @retval Others                   The events cannot be created.
+
+**/
+EFI_STATUS
+OutputQueueInitialize (
+  VOID
+  )
+{
+  EFI_STATUS                      Status;
+
+  Status = gBS->CreateEvent (
+                  EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  OutputQueueNotify,
+                  NULL,
+                  &mOutputQueueTimerEvent
+                  );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = gBS->CreateEventEx (
+                  EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  OutputQueueNotify,
+                  NULL,
+                  &gIdleLoopEventGuid,
+                  &mOutputQueueIdleEvent
+                  );
+  if (EFI_ERROR (Status)) {
+    gBS->CloseEvent (mOutputQueueTimerEvent);
+    return Status;
+  }
+
+  Status = gBS->CreateEventEx (
+                  EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  OutputQueueExitBootServicesNotify,
+                  NULL,
+                  &gEfiEventExitBootServicesGuid,
+                  &mOutputQueueExitBootServicesEvent
+                  );
+  if (EFI_ERROR (Status)) {
+    gBS->CloseEvent (mOutputQueueIdleEvent);
+    gBS->CloseEvent (mOutputQueueTimerEvent);
+    return Status;
+  }
+
+  mOutputQueueEnabled = TRUE;
+  return EFI_SUCCESS;
+}
+
+/**
+  Get the output queue of a text output device, creating it if it is not
+  shared with the other splitter yet.
+
+  @param  TextOut                  Simple Text Output protocol pointer.
+
+  @return The output queue, or NULL if the device is written synchronously.
+
+**/
+OUTPUT_QUEUE *
+OutputQueueAttach (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL    *TextOut
+  )
+{
+  LIST_ENTRY                      *Link;
+  OUTPUT_QUEUE                    *Queue;
+
+  if (!mOutputQueueEnabled) {
+    return NULL;
+  }
+
+  for (Link = GetFirstNode (&mOutputQueueList); !IsNull (&mOutputQueueList, Link); Link = GetNextNode (&mOutputQueueList, Link)) {
+    Queue = OUTPUT_QUEUE_FROM_LINK (Link);
+    if (Queue->TextOut == TextOut) {
+      Queue->ReferenceCount++;
+      return Queue;
+    }
+  }
+
+  Queue = AllocateZeroPool (sizeof (OUTPUT_QUEUE));
+  if (Queue == NULL) {
+    return NULL;
+  }
+  Queue->Signature      = OUTPUT_QUEUE_SIGNATURE;
+  Queue->TextOut        = TextOut;
+  Queue->ReferenceCount = 1;
+  Queue->Status         = EFI_SUCCESS;
+  InsertTailList (&mOutputQueueList, &Queue->Link);
+
+  return Queue;
+}
+
+/**
+  Flush the output queue of a text output device that is removed from a
+  splitter, and free it when no splitter uses it any more.
+
+  If the removal interrupted a caller draining the queue or adding to it, the
+  queue is freed when that caller is done with it.
+
+  @param  Queue                    The output queue.
+
+**/
+VOID
+OutputQueueDetach (
+  IN  OUTPUT_QUEUE                       *Queue
+  )
+{
+  EFI_TPL                         OldTpl;
+  BOOLEAN                         Free;
+
+  OutputQueueDrain (Queue, MAX_UINTN);
+
+  ASSERT (Queue->ReferenceCount > 0);
+  Queue->ReferenceCount--;
+  if (Queue->ReferenceCount == 0) {
+    //
+    // Devices are removed at TPL_CALLBACK or below, so this never interrupts
+    // the timer and idle loop events walking the list.
+    //
+    RemoveEntryList (&Queue->Link);
+
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+    Free   = (BOOLEAN) (Queue->InUse == 0);
+    if (!Free) {
+      Queue->FreePending = TRUE;
+    }
+    gBS->RestoreTPL (OldTpl);
+
+    if (Free) {
+      FreePool (Queue);
+    }
+  }
+}
+
+/**
+  Check whether the device has the attribute once the queued requests are sent.
+
+  @param  Queue                    The output queue.
+  @param  Attribute                The attribute to check.
+
+  @retval TRUE                     The last queued SetAttribute request, or the
+                                   current attribute of the device if none is
+                                   queued, sets the same attribute.
+  @retval FALSE                    The attribute has to be set.
+
+**/
+BOOLEAN
+OutputQueueHasAttribute (
+  IN  OUTPUT_QUEUE                       *Queue,
+  IN  UINTN                              Attribute
+  )
+{
+  EFI_TPL                         OldTpl;
+  OUTPUT_QUEUE_REQUEST            *Request;
+  UINTN                           Index;
+  UINTN                           LastAttribute;
+
+  OldTpl        = gBS->RaiseTPL (TPL_NOTIFY);
+  LastAttribute = (UINTN) Queue->TextOut->Mode->Attribute;
+  for (Index = Queue->Count; Index > 0; Index--) {
+    Request = &Queue->Request[(Queue->Head + Index - 1) % OUTPUT_QUEUE_DEPTH];
+    if (Request->Type == OutputQueueSetAttribute) {
+      LastAttribute = Request->Argument[0];
+      break;
+    }
+  }
+  gBS->RestoreTPL (OldTpl);
+
+  return (BOOLEAN) (LastAttribute == Attribute);
+}
+
+/**
+  Add a request to the output queue of a text output device. If the queue is
+  full, the oldest requests are sent to the device first. A SetAttribute
+  request that does not change the attribute is dropped, so that it does not
+  split the strings output with the same attribute.
+
+  @param  Queue                    The output queue.
+  @param  Type                     The type of the request.
+  @param  Argument0                The first argument of the request.
+  @param  Argument1                The second argument of the request.
+  @param  String                   The string to output for an
+                                   OutputQueueOutputString request.
+
+  @retval EFI_SUCCESS              The request is queued.
+  @retval EFI_DEVICE_ERROR         The device reported an error for an earlier
+                                   request.
+
+**/
+EFI_STATUS
+OutputQueueAdd (
+  IN  OUTPUT_QUEUE                       *Queue,
+  IN  OUTPUT_QUEUE_REQUEST_TYPE          Type,
+  IN  UINTN                              Argument0,
+  IN  UINTN                              Argument1,
+  IN  CHAR16                             *String     OPTIONAL
+  )
+{
+  EFI_TPL                         OldTpl;
+  EFI_STATUS                      Status;
+  OUTPUT_QUEUE_REQUEST            *Request;
+  OUTPUT_QUEUE_REQUEST            DirectRequest;
+  UINTN                           Length;
+
+  OutputQueueAcquire (Queue);
+
+  //
+  // The splitter sets the attribute again before every string it outputs.
+  //
+  if ((Type == OutputQueueSetAttribute) && OutputQueueHasAttribute (Queue, Argument0)) {
+    goto Done;
+  }
+
+  do {
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+
+    //
+    // A string is appended to the last queued string unless that one is being
+    // sent to the device.
+    //
+    Request = NULL;
+    if (mOutputQueueEnabled && (Type == OutputQueueOutputString) &&
+        (Queue->Count != 0) && (!Queue->Draining || (Queue->Count > 1))) {
+      Request = &Queue->Request[(Queue->Head + Queue->Count - 1) % OUTPUT_QUEUE_DEPTH];
+      if ((Request->Type != OutputQueueOutputString) || (Request->Length == OUTPUT_QUEUE_STRING_LENGTH)) {
+        Request = NULL;
+      }
+    }
+
+    if ((Request == NULL) && (Queue->Count < OUTPUT_QUEUE_DEPTH) && mOutputQueueEnabled) {
+      Request = &Queue->Request[(Queue->Head + Queue->Count) % OUTPUT_QUEUE_DEPTH];
+      Request->Type        = Type;
+      Request->Argument[0] = Argument0;
+      Request->Argument[1] = Argument1;
+      Request->Length      = 0;
+      Request->String[0]   = CHAR_NULL;
+      Queue->Count++;
+      OutputQueueStartTimer ();
+    }
+
+    if (Request != NULL) {
+      if (Type == OutputQueueOutputString) {
+        for (Length = Request->Length; (Length < OUTPUT_QUEUE_STRING_LENGTH) && (*String != CHAR_NULL); Length++, String++) {
+          Request->String[Length] = *String;
+        }
+        Request->String[Length] = CHAR_NULL;
+        Request->Length         = Length;
+      }
+      gBS->RestoreTPL (OldTpl);
+      continue;
+    }
+
+    if (!Queue->Draining && mOutputQueueEnabled) {
+      //
+      // The queue is full, make room by sending the oldest requests.
+      //
+      gBS->RestoreTPL (OldTpl);
+      OutputQueueDrain (Queue, OUTPUT_QUEUE_DRAIN_COUNT);
+      continue;
+    }
+    gBS->RestoreTPL (OldTpl);
+
+    if (mOutputQueueEnabled) {
+      //
+      // The queue is full while the interrupted caller is draining it. The
+      // device is busy with that caller's request and the older requests
+      // have to be sent first, so the request is dropped.
+      //
+      Queue->Dropped++;
+      DEBUG ((EFI_D_WARN, "ConSplitter: Output queue is full while being drained, %d requests dropped\n", Queue->Dropped));
+      break;
+    }
+
+    //
+    // The queues are not used any more, the request is sent directly.
+    //
+    DirectRequest.Type        = Type;
+    DirectRequest.Argument[0] = Argument0;
+    DirectRequest.Argument[1] = Argument1;
+    for (Length = 0; (Length < OUTPUT_QUEUE_STRING_LENGTH) && (String != NULL) && (*String != CHAR_NULL); Length++, String++) {
+      DirectRequest.String[Length] = *String;
+    }
+    DirectRequest.String[Length] = CHAR_NULL;
+    DirectRequest.Length         = Length;
+    Status = OutputQueueSendRequest (Queue->TextOut, &DirectRequest);
+    if (EFI_ERROR (Status) && (Status != EFI_UNSUPPORTED)) {
+      Queue->Status = EFI_DEVICE_ERROR;
+    }
+  } while ((Type == OutputQueueOutputString) && (*String != CHAR_NULL));
+
+Done:
+  OldTpl        = gBS->RaiseTPL (TPL_NOTIFY);
+  Status        = Queue->Status;
+  Queue->Status = EFI_SUCCESS;
+  gBS->RestoreTPL (OldTpl);
+
+  OutputQueueRelease (Queue);
+
+  return Status;
+}
+
+/**
+  Send all queued requests to the text output devices of a splitter.
+
+  @param  Private                  Text Out Splitter pointer.
+
+**/
+VOID
+OutputQueueFlush (
+  IN  TEXT_OUT_SPLITTER_PRIVATE_DATA     *Private
+  )
+{
+  UINTN                           Index;
+
+  for (Index = 0; Index < Private->CurrentNumberOfConsoles; Index++) {
+    if (Private->TextOutList[Index].OutputQueue != NULL) {
+      OutputQueueDrain (Private->TextOutList[Index].OutputQueue, MAX_UINTN);
+    }
+  }
+}
+
+/**
+  Send all queued requests to all text output devices. It is called before
+  ExitBootServices() completes, and may be called whenever all output needs
+  to have reached the devices.
+
+**/
+VOID
+OutputQueueFlushAll (
+  VOID
+  )
+{
+  LIST_ENTRY                      *Link;
+
+  for (Link = GetFirstNode (&mOutputQueueList); !IsNull (&mOutputQueueList, Link); Link = GetNextNode (&mOutputQueueList, Link)) {
+    OutputQueueDrain (OUTPUT_QUEUE_FROM_LINK (Link), MAX_UINTN);
+  }
+}
@@ -93,6 +93,11 @@ EFI_NARROW_GLYPH     mCursorGlyph = {
 
 CHAR16       SpaceStr[] = { NARROW_CHAR, ' ', 0 };
 
+GRAPHICS_CONSOLE_GLYPH         mGlyphCache[GLYPH_CACHE_SIZE];
+EFI_GRAPHICS_OUTPUT_BLT_PIXEL  mGlyphForeground;
+BOOLEAN                        mGlyphForegroundValid = FALSE;
+BOOLEAN                        mGlyphCacheNotifyRegistered = FALSE;
+
 EFI_DRIVER_BINDING_PROTOCOL gGraphicsConsoleDriverBinding = {
   GraphicsConsoleControllerDriverSupported,
   GraphicsConsoleControllerDriverStart,
@@ -1723,6 +1728,281 @@ GetTextColors (
   return EFI_SUCCESS;
 }
 
+/**
+  Empty the glyph cache when font packages are added, updated or removed,
+  since the system font glyphs may change.
+
+  @param PackageType  Package type of the notification.
+  @param PackageGuid  If PackageType is EFI_HII_PACKAGE_TYPE_GUID, then this is
+                      the pointer to the GUID from the Guid field of
+                      EFI_HII_PACKAGE_GUID_HEADER. Otherwise, it must be NULL.
+  @param Package      Points to the package referred to by the notification.
+  @param Handle       The HII handle.
+  @param NotifyType   The type of change concerning the database.
+
+  @retval EFI_SUCCESS The glyph cache is emptied.
+
+**/
+EFI_STATUS
+EFIAPI
+GlyphCacheNotify (
+  IN UINT8                              PackageType,
+  IN CONST EFI_GUID                     *PackageGuid,
+  IN CONST EFI_HII_PACKAGE_HEADER       *Package,
+  IN EFI_HII_HANDLE                     Handle,
+  IN EFI_HII_DATABASE_NOTIFY_TYPE       NotifyType
+  )
+{
+  ZeroMem (mGlyphCache, sizeof (mGlyphCache));
+  mGlyphForegroundValid = FALSE;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Register the notifications emptying the glyph cache when the font packages
+  in the HII database change.
+
+  @retval EFI_SUCCESS           The notifications are registered.
+  @retval others                A notification cannot be registered.
+
+**/
+EFI_STATUS
+RegisterGlyphCacheNotify (
+  VOID
+  )
+{
+  EFI_STATUS                           Status;
+  EFI_HANDLE                           NotifyHandle[6];
+  UINTN                                NotifyCount;
+  UINTN                                PackageIndex;
+  UINTN                                NotifyIndex;
+  UINT8                                PackageType[2];
+  EFI_HII_DATABASE_NOTIFY_TYPE         NotifyType[3];
+
+  PackageType[0] = EFI_HII_PACKAGE_FONTS;
+  PackageType[1] = EFI_HII_PACKAGE_SIMPLE_FONTS;
+  NotifyType[0]  = EFI_HII_DATABASE_NOTIFY_NEW_PACK;
+  NotifyType[1]  = EFI_HII_DATABASE_NOTIFY_ADD_PACK;
+  NotifyType[2]  = EFI_HII_DATABASE_NOTIFY_REMOVE_PACK;
+  NotifyCount    = 0;
+
+  for (PackageIndex = 0; PackageIndex < sizeof (PackageType) / sizeof (PackageType[0]); PackageIndex++) {
+    for (NotifyIndex = 0; NotifyIndex < sizeof (NotifyType) / sizeof (NotifyType[0]); NotifyIndex++) {
+      Status = mHiiDatabase->RegisterPackageNotify (
+                               mHiiDatabase,
+                               PackageType[PackageIndex],
+                               NULL,
+                               GlyphCacheNotify,
+                               NotifyType[NotifyIndex],
+                               &NotifyHandle[NotifyCount]
+                               );
+      if (EFI_ERROR (Status)) {
+        //
+        // Unregister the notifications registered so far, they are all
+        // registered again on the next attempt.
+        //
+        while (NotifyCount > 0) {
+          NotifyCount--;
+          mHiiDatabase->UnregisterPackageNotify (mHiiDatabase, NotifyHandle[NotifyCount]);
+        }
+        return Status;
+      }
+      NotifyCount++;
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Get the cached glyph of a character, filling the cache entry from the
+  system font through HII Font on the first use.
+
+  Only the glyphs that HII Font renders as a full EFI_GLYPH_WIDTH by
+  EFI_GLYPH_HEIGHT cell with no vertical offset, as the narrow glyphs of the
+  simple fonts are, are cached. The other characters, including those missing
+  from the font, keep going through StringToImage so that they are drawn
+  exactly as before. GetGlyph does not report the horizontal offset of a
+  glyph, so a full cell glyph of a font package with such an offset is cached
+  without it.
+
+  @param  Char                  The character.
+
+  @return The cached glyph, or NULL if the character cannot be drawn from
+          the glyph cache.
+
+**/
+GRAPHICS_CONSOLE_GLYPH *
+GetCachedGlyph (
+  IN  CHAR16                           Char
+  )
+{
+  EFI_STATUS                           Status;
+  GRAPHICS_CONSOLE_GLYPH               *Glyph;
+  EFI_FONT_DISPLAY_INFO                *SystemFont;
+  EFI_IMAGE_OUTPUT                     *Image;
+  UINTN                                Baseline;
+  UINTN                                PosX;
+  UINTN                                PosY;
+
+  if (Char < GLYPH_CACHE_RANGE_SIZE) {
+    Glyph = &mGlyphCache[Char];
+  } else if ((UINTN) (Char - GLYPH_CACHE_BOX_DRAWING_BASE) < GLYPH_CACHE_RANGE_SIZE) {
+    Glyph = &mGlyphCache[GLYPH_CACHE_RANGE_SIZE + Char - GLYPH_CACHE_BOX_DRAWING_BASE];
+  } else {
+    return NULL;
+  }
+
+  if (Glyph->State == GLYPH_CACHE_STATE_EMPTY) {
+    //
+    // The cache is only used once it is emptied whenever the fonts change.
+    //
+    if (!mGlyphCacheNotifyRegistered) {
+      if (EFI_ERROR (RegisterGlyphCacheNotify ())) {
+        return NULL;
+      }
+      mGlyphCacheNotifyRegistered = TRUE;
+    }
+
+    //
+    // The system font is rendered in its default foreground color, which
+    // tells the glyph pixels apart from the background pixels.
+    //
+    if (!mGlyphForegroundValid) {
+      SystemFont = NULL;
+      Status = mHiiFont->GetFontInfo (mHiiFont, NULL, NULL, &SystemFont, NULL);
+      if (EFI_ERROR (Status)) {
+        return NULL;
+      }
+      if (CompareMem (&SystemFont->ForegroundColor, &SystemFont->BackgroundColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)) == 0) {
+        FreePool (SystemFont);
+        return NULL;
+      }
+      mGlyphForeground      = SystemFont->ForegroundColor;
+      mGlyphForegroundValid = TRUE;
+      FreePool (SystemFont);
+    }
+
+    Glyph->State = GLYPH_CACHE_STATE_UNCACHED;
+    Image        = NULL;
+    Baseline     = 0;
+    Status       = mHiiFont->GetGlyph (mHiiFont, Char, NULL, &Image, &Baseline);
+    if (Status != EFI_SUCCESS) {
+      if (Image != NULL) {
+        FreePool (Image->Image.Bitmap);
+        FreePool (Image);
+      }
+      return NULL;
+    }
+
+    //
+    // GetGlyph returns the vertical offset of the glyph as its baseline.
+    //
+    if ((Image->Width == EFI_GLYPH_WIDTH) && (Image->Height == EFI_GLYPH_HEIGHT) && (Baseline == 0)) {
+      for (PosY = 0; PosY < EFI_GLYPH_HEIGHT; PosY++) {
+        Glyph->GlyphCol1[PosY] = 0;
+        for (PosX = 0; PosX < EFI_GLYPH_WIDTH; PosX++) {
+          if (CompareMem (
+                &Image->Image.Bitmap[PosY * EFI_GLYPH_WIDTH + PosX],
+                &mGlyphForeground,
+                sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+                ) == 0) {
+            Glyph->GlyphCol1[PosY] |= (UINT8) (BIT7 >> PosX);
+          }
+        }
+      }
+      Glyph->State = GLYPH_CACHE_STATE_VALID;
+    }
+
+    FreePool (Image->Image.Bitmap);
+    FreePool (Image);
+  }
+
+  return (Glyph->State == GLYPH_CACHE_STATE_VALID) ? Glyph : NULL;
+}
+
+/**
+  Draw Unicode string on the Graphics Console device's screen from the glyph
+  cache, using the line buffer and one Graphics Output Blt.
+
+  The string is drawn only if every character is in the glyph cache and the
+  wide attribute is off, otherwise nothing is drawn and the caller falls back
+  to HII Font.
+
+  @param  This                  Protocol instance pointer.
+  @param  UnicodeWeight         One Unicode string to be displayed.
+  @param  Count                 The count of Unicode string.
+
+  @retval EFI_UNSUPPORTED       The string cannot be drawn from the glyph cache.
+  @retval others                The status returned by Graphics Output Blt.
+
+**/
+EFI_STATUS
+DrawCachedGlyphsAtCursorN (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL  *This,
+  IN  CHAR16                           *UnicodeWeight,
+  IN  UINTN                            Count
+  )
+{
+  GRAPHICS_CONSOLE_DEV                 *Private;
+  GRAPHICS_CONSOLE_MODE_DATA           *ModeData;
+  GRAPHICS_CONSOLE_GLYPH               *Glyph;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL        Foreground;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL        Background;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL        *Pixel;
+  UINTN                                Width;
+  UINTN                                Index;
+  UINTN                                PosX;
+  UINTN                                PosY;
+  UINT8                                Row;
+
+  Private  = GRAPHICS_CONSOLE_CON_OUT_DEV_FROM_THIS (This);
+  ModeData = &Private->ModeData[This->Mode->Mode];
+
+  if ((Private->GraphicsOutput == NULL) || (Private->LineBuffer == NULL) ||
+      ((This->Mode->Attribute & EFI_WIDE_ATTRIBUTE) != 0) ||
+      (Count == 0) || (This->Mode->CursorColumn + Count > ModeData->Columns)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  GetTextColors (This, &Foreground, &Background);
+
+  //
+  // Expand the glyphs into the line buffer, one pixel row of the string at a
+  // time. The line buffer is only a scratch buffer, so a character missing
+  // from the glyph cache simply abandons it.
+  //
+  Width = Count * EFI_GLYPH_WIDTH;
+  for (Index = 0; Index < Count; Index++) {
+    Glyph = GetCachedGlyph (UnicodeWeight[Index]);
+    if (Glyph == NULL) {
+      return EFI_UNSUPPORTED;
+    }
+    Pixel = Private->LineBuffer + Index * EFI_GLYPH_WIDTH;
+    for (PosY = 0; PosY < EFI_GLYPH_HEIGHT; PosY++) {
+      Row = Glyph->GlyphCol1[PosY];
+      for (PosX = 0; PosX < EFI_GLYPH_WIDTH; PosX++) {
+        Pixel[PosX] = ((Row & (BIT7 >> PosX)) != 0) ? Foreground : Background;
+      }
+      Pixel += Width;
+    }
+  }
+
+  return Private->GraphicsOutput->Blt (
+                                    Private->GraphicsOutput,
+                                    Private->LineBuffer,
+                                    EfiBltBufferToVideo,
+                                    0,
+                                    0,
+                                    This->Mode->CursorColumn * EFI_GLYPH_WIDTH + ModeData->DeltaX,
+                                    This->Mode->CursorRow * EFI_GLYPH_HEIGHT + ModeData->DeltaY,
+                                    Width,
+                                    EFI_GLYPH_HEIGHT,
+                                    Width * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+                                    );
+}
+
 /**
   Draw Unicode string on the Graphics Console device's screen.
 
@@ -1753,6 +2033,16 @@ DrawUnicodeWeightAtCursorN (
   UINTN                             RowInfoArraySize;
 
   Private = GRAPHICS_CONSOLE_CON_OUT_DEV_FROM_THIS (This);
+
+  //
+  // Most of the console text is in the glyph cache. It is drawn without the
+  // allocations and the glyph lookups of HII Font StringToImage.
+  //
+  Status = DrawCachedGlyphsAtCursorN (This, UnicodeWeight, Count);
+  if (Status != EFI_UNSUPPORTED) {
+    return Status;
+  }
+
   Blt = (EFI_IMAGE_OUTPUT *) AllocateZeroPool (sizeof (EFI_IMAGE_OUTPUT));
   if (Blt == NULL) {
     return EFI_OUT_OF_RESOURCES;
@@ -76,6 +76,25 @@ typedef struct {
 #define GRAPHICS_CONSOLE_CON_OUT_DEV_FROM_THIS(a) \
   CR (a, GRAPHICS_CONSOLE_DEV, SimpleTextOutput, GRAPHICS_CONSOLE_DEV_SIGNATURE)
 
+//
+// Glyph cache. The narrow glyphs of the system font in the Basic Latin,
+// Latin-1 and Box Drawing/Block Elements/Geometric Shapes ranges are kept as
+// monochrome bitmaps, so the console text in these ranges is expanded into
+// the line buffer and drawn with a single Blt, without HII Font.
+//
+#define GLYPH_CACHE_RANGE_SIZE        0x100
+#define GLYPH_CACHE_BOX_DRAWING_BASE  0x2500
+#define GLYPH_CACHE_SIZE              (GLYPH_CACHE_RANGE_SIZE * 2)
+
+#define GLYPH_CACHE_STATE_EMPTY       0
+#define GLYPH_CACHE_STATE_VALID       1
+#define GLYPH_CACHE_STATE_UNCACHED    2
+
+typedef struct {
+  UINT8   State;
+  UINT8   GlyphCol1[EFI_GLYPH_HEIGHT];
+} GRAPHICS_CONSOLE_GLYPH;
+
 
 //
 // EFI Component Name Functions
@@ -552,6 +571,78 @@ DrawUnicodeWeightAtCursorN (
   IN  UINTN                            Count
   );
 
+/**
+  Empty the glyph cache when font packages are added, updated or removed,
+  since the system font glyphs may change.
+
+  @param PackageType  Package type of the notification.
+  @param PackageGuid  If PackageType is EFI_HII_PACKAGE_TYPE_GUID, then this is
+                      the pointer to the GUID from the Guid field of
+                      EFI_HII_PACKAGE_GUID_HEADER. Otherwise, it must be NULL.
+  @param Package      Points to the package referred to by the notification.
+  @param Handle       The HII handle.
+  @param NotifyType   The type of change concerning the database.
+
+  @retval EFI_SUCCESS The glyph cache is emptied.
+
+**/
+EFI_STATUS
+EFIAPI
+GlyphCacheNotify (
+  IN UINT8                              PackageType,
+  IN CONST EFI_GUID                     *PackageGuid,
+  IN CONST EFI_HII_PACKAGE_HEADER       *Package,
+  IN EFI_HII_HANDLE                     Handle,
+  IN EFI_HII_DATABASE_NOTIFY_TYPE       NotifyType
+  );
+
+/**
+  Register the notifications emptying the glyph cache when the font packages
+  in the HII database change.
+
+  @retval EFI_SUCCESS           The notifications are registered.
+  @retval others                A notification cannot be registered.
+
+**/
+EFI_STATUS
+RegisterGlyphCacheNotify (
+  VOID
+  );
+
+/**
+  Get the cached glyph of a character, filling the cache entry from the
+  system font through HII Font on the first use.
+
+  @param  Char                  The character.
+
+  @return The cached glyph, or NULL if the character cannot be drawn from
+          the glyph cache.
+
+**/
+GRAPHICS_CONSOLE_GLYPH *
+GetCachedGlyph (
+  IN  CHAR16                           Char
+  );
+
+/**
+  Draw Unicode string on the Graphics Console device's screen from the glyph
+  cache, using the line buffer and one Graphics Output Blt.
+
+  @param  This                  Protocol instance pointer.
+  @param  UnicodeWeight         One Unicode string to be displayed.
+  @param  Count                 The count of Unicode string.
+
+  @retval EFI_UNSUPPORTED       The string cannot be drawn from the glyph cache.
+  @retval others                The status returned by Graphics Output Blt.
+
+**/
+EFI_STATUS
+DrawCachedGlyphsAtCursorN (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL  *This,
+  IN  CHAR16                           *UnicodeWeight,
+  IN  UINTN                            Count
+  );
+
 /**
   Flush the cursor on the screen.
   
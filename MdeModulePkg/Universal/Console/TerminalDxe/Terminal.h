@@ -43,6 +43,11 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
 
 #define RAW_FIFO_MAX_NUMBER 256
+
+//
+// Size of the buffer collecting the output bytes for one serial write.
+//
+#define TERMINAL_OUTPUT_BUFFER_SIZE 512
 #define FIFO_MAX_NUMBER     128
 
 typedef struct {
@@ -112,6 +117,21 @@ typedef struct {
   BOOLEAN                             OutputEscChar;
   EFI_SIMPLE_TEXT_INPUT_EX_PROTOCOL   SimpleInputEx;
   LIST_ENTRY                          NotifyList;
+
+  //
+  // The bytes of an output string are collected here and written to the
+  // serial device at once.
+  //
+  UINT8                               OutputBuffer[TERMINAL_OUTPUT_BUFFER_SIZE];
+  UINTN                               OutputLength;
+
+  //
+  // Indicate whether the cursor position and the attribute in
+  // SimpleTextOutputMode are known to match the terminal emulation
+  // software, so that the control sequences can be skipped or shortened.
+  //
+  BOOLEAN                             CursorPositionKnown;
+  BOOLEAN                             AttributeKnown;
 } TERMINAL_DEV;
 
 #define INPUT_STATE_DEFAULT               0x00
@@ -152,9 +172,6 @@ typedef union {
 #define ESC                       27
 #define CSI                       0x9B
 #define DEL                       127
-#define BRIGHT_CONTROL_OFFSET     2
-#define FOREGROUND_CONTROL_OFFSET 6
-#define BACKGROUND_CONTROL_OFFSET 11
 #define ROW_OFFSET                2
 #define COLUMN_OFFSET             5
 
@@ -1315,6 +1332,39 @@ TerminalIsValidAscii (
   IN  CHAR16  Ascii
   );
 
+/**
+  Write the bytes collected in the output buffer to the serial device.
+
+  @param  TerminalDevice       The terminal device.
+
+  @retval EFI_SUCCESS          The bytes are written.
+  @retval Others               The serial device fails to write the bytes.
+
+**/
+EFI_STATUS
+TerminalFlushOutput (
+  IN TERMINAL_DEV  *TerminalDevice
+  );
+
+/**
+  Add bytes to the output buffer, writing the buffer to the serial device
+  first if it is full.
+
+  @param  TerminalDevice       The terminal device.
+  @param  Buffer               The bytes to output.
+  @param  Length               The number of bytes.
+
+  @retval EFI_SUCCESS          The bytes are added to the output buffer.
+  @retval Others               The serial device fails to write the buffer.
+
+**/
+EFI_STATUS
+TerminalBufferOutput (
+  IN TERMINAL_DEV  *TerminalDevice,
+  IN UINT8         *Buffer,
+  IN UINTN         Length
+  );
+
 /**
   Detects if a valid EFI control character.
 
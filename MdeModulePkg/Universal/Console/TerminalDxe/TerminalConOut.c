@@ -79,7 +79,6 @@ UNICODE_TO_CHAR  UnicodeToPcAnsiOrAscii[] = {
 };
 
 CHAR16 mSetModeString[]            = { ESC, '[', '=', '3', 'h', 0 };
-CHAR16 mSetAttributeString[]       = { ESC, '[', '0', 'm', ESC, '[', '4', '0', 'm', ESC, '[', '4', '0', 'm', 0 };
 CHAR16 mClearScreenString[]        = { ESC, '[', '2', 'J', 0 };
 CHAR16 mSetCursorPositionString[]  = { ESC, '[', '0', '0', ';', '0', '0', 'H', 0 };
 
@@ -179,7 +178,6 @@ TerminalConOutOutputString (
   EFI_SIMPLE_TEXT_OUTPUT_MODE *Mode;
   UINTN                       MaxColumn;
   UINTN                       MaxRow;
-  UINTN                       Length;
   UTF8_CHAR                   Utf8Char;
   CHAR8                       GraphicChar;
   CHAR8                       AsciiChar;
@@ -253,14 +251,7 @@ TerminalConOutOutputString (
         GraphicChar = AsciiChar;
       }
 
-      Length = 1;
-
-      Status = TerminalDevice->SerialIo->Write (
-                                          TerminalDevice->SerialIo,
-                                          &Length,
-                                          &GraphicChar
-                                          );
-
+      Status = TerminalBufferOutput (TerminalDevice, (UINT8 *) &GraphicChar, 1);
       if (EFI_ERROR (Status)) {
         goto OutputError;
       }
@@ -269,17 +260,32 @@ TerminalConOutOutputString (
 
     case VTUTF8TYPE:
       UnicodeToUtf8 (*WString, &Utf8Char, &ValidBytes);
-      Length = ValidBytes;
-      Status = TerminalDevice->SerialIo->Write (
-                                          TerminalDevice->SerialIo,
-                                          &Length,
-                                          (UINT8 *) &Utf8Char
-                                          );
+      Status = TerminalBufferOutput (TerminalDevice, (UINT8 *) &Utf8Char, ValidBytes);
       if (EFI_ERROR (Status)) {
         goto OutputError;
       }
+
+      //
+      // The terminal emulation software may show other characters than
+      // ASCII and text graphics in two columns, or none.
+      //
+      if ((*WString > 0x7E) && !TerminalIsValidTextGraphics (*WString, NULL, NULL)) {
+        TerminalDevice->CursorPositionKnown = FALSE;
+      }
       break;
     }
+
+    if (!TerminalDevice->OutputEscChar) {
+      //
+      // After the last column, the terminal emulation software either
+      // wraps the line, scrolls or keeps the cursor there. Tab stops are
+      // not tracked either.
+      //
+      if ((*WString == CHAR_TAB) || (Mode->CursorColumn == (INT32) (MaxColumn - 1))) {
+        TerminalDevice->CursorPositionKnown = FALSE;
+      }
+    }
+
     //
     //  Update cursor position.
     //
@@ -320,6 +326,11 @@ TerminalConOutOutputString (
 
   }
 
+  Status = TerminalFlushOutput (TerminalDevice);
+  if (EFI_ERROR (Status)) {
+    goto OutputError;
+  }
+
   if (Warning) {
     return EFI_WARN_UNKNOWN_GLYPH;
   }
@@ -327,6 +338,9 @@ TerminalConOutOutputString (
   return EFI_SUCCESS;
 
 OutputError:
+  TerminalDevice->OutputLength        = 0;
+  TerminalDevice->CursorPositionKnown = FALSE;
+
   REPORT_STATUS_CODE_WITH_DEVICE_PATH (
     EFI_ERROR_CODE | EFI_ERROR_MINOR,
     (EFI_PERIPHERAL_REMOTE_CONSOLE | EFI_P_EC_OUTPUT_ERROR),
@@ -517,6 +531,9 @@ TerminalConOutSetAttribute (
   INT32         SavedRow;
   EFI_STATUS    Status;
   TERMINAL_DEV  *TerminalDevice;
+  UINTN         ChangedBits;
+  UINTN         Index;
+  CHAR16        SetAttributeString[12];
 
   SavedColumn = 0;
   SavedRow    = 0;
@@ -537,7 +554,7 @@ TerminalConOutSetAttribute (
   // Skip outputting the command string for the same attribute
   // It improves the terminal performance significantly
   //
-  if (This->Mode->Attribute == (INT32) Attribute) {
+  if (TerminalDevice->AttributeKnown && (This->Mode->Attribute == (INT32) Attribute)) {
     return EFI_SUCCESS;
   }
 
@@ -629,13 +646,36 @@ TerminalConOutSetAttribute (
     break;
   }
   //
-  // terminal emulator's control sequence to set attributes
+  // terminal emulator's control sequence to set attributes. Setting the
+  // bright control resets all attributes, so when it does not change,
+  // only the changed colors are sent.
   //
-  mSetAttributeString[BRIGHT_CONTROL_OFFSET]          = (CHAR16) ('0' + BrightControl);
-  mSetAttributeString[FOREGROUND_CONTROL_OFFSET + 0]  = (CHAR16) ('0' + (ForegroundControl / 10));
-  mSetAttributeString[FOREGROUND_CONTROL_OFFSET + 1]  = (CHAR16) ('0' + (ForegroundControl % 10));
-  mSetAttributeString[BACKGROUND_CONTROL_OFFSET + 0]  = (CHAR16) ('0' + (BackgroundControl / 10));
-  mSetAttributeString[BACKGROUND_CONTROL_OFFSET + 1]  = (CHAR16) ('0' + (BackgroundControl % 10));
+  ChangedBits = 0xFF;
+  if (TerminalDevice->AttributeKnown) {
+    ChangedBits = (UINTN) This->Mode->Attribute ^ Attribute;
+  }
+
+  Index = 0;
+  SetAttributeString[Index++] = ESC;
+  SetAttributeString[Index++] = '[';
+  if ((ChangedBits & EFI_BRIGHT) != 0) {
+    SetAttributeString[Index++] = (CHAR16) ('0' + BrightControl);
+    SetAttributeString[Index++] = ';';
+    ChangedBits = 0xFF;
+  }
+  if ((ChangedBits & 0x07) != 0) {
+    SetAttributeString[Index++] = (CHAR16) ('0' + (ForegroundControl / 10));
+    SetAttributeString[Index++] = (CHAR16) ('0' + (ForegroundControl % 10));
+  }
+  if (((ChangedBits & 0x07) != 0) && ((ChangedBits & 0x70) != 0)) {
+    SetAttributeString[Index++] = ';';
+  }
+  if ((ChangedBits & 0x70) != 0) {
+    SetAttributeString[Index++] = (CHAR16) ('0' + (BackgroundControl / 10));
+    SetAttributeString[Index++] = (CHAR16) ('0' + (BackgroundControl % 10));
+  }
+  SetAttributeString[Index++] = 'm';
+  SetAttributeString[Index]   = CHAR_NULL;
 
   //
   // save current column and row
@@ -645,10 +685,11 @@ TerminalConOutSetAttribute (
   SavedRow                      = This->Mode->CursorRow;
 
   TerminalDevice->OutputEscChar = TRUE;
-  Status                        = This->OutputString (This, mSetAttributeString);
+  Status                        = This->OutputString (This, SetAttributeString);
   TerminalDevice->OutputEscChar = FALSE;
 
   if (EFI_ERROR (Status)) {
+    TerminalDevice->AttributeKnown = FALSE;
     return EFI_DEVICE_ERROR;
   }
   //
@@ -657,7 +698,8 @@ TerminalConOutSetAttribute (
   This->Mode->CursorColumn  = SavedColumn;
   This->Mode->CursorRow     = SavedRow;
 
-  This->Mode->Attribute     = (INT32) Attribute;
+  This->Mode->Attribute          = (INT32) Attribute;
+  TerminalDevice->AttributeKnown = TRUE;
 
   return EFI_SUCCESS;
 
@@ -698,6 +740,10 @@ TerminalConOutClearScreen (
     return EFI_DEVICE_ERROR;
   }
 
+  //
+  // Clearing the screen does not move the cursor on all terminals.
+  //
+  TerminalDevice->CursorPositionKnown = FALSE;
   Status = This->SetCursorPosition (This, 0, 0);
 
   return Status;
@@ -730,6 +776,9 @@ TerminalConOutSetCursorPosition (
   UINTN                       MaxRow;
   EFI_STATUS                  Status;
   TERMINAL_DEV                *TerminalDevice;
+  CHAR16                      MoveCursorString[8];
+  CHAR16                      *String;
+  UINTN                       Count;
 
   TerminalDevice = TERMINAL_CON_OUT_DEV_FROM_THIS (This);
 
@@ -754,19 +803,71 @@ TerminalConOutSetCursorPosition (
   if (Column >= MaxColumn || Row >= MaxRow) {
     return EFI_UNSUPPORTED;
   }
+
+  if (TerminalDevice->CursorPositionKnown &&
+      (Mode->CursorColumn == (INT32) Column) && (Mode->CursorRow == (INT32) Row)) {
+    return EFI_SUCCESS;
+  }
+
   //
-  // control sequence to move the cursor
+  // control sequence to move the cursor. When the current cursor position is
+  // known, shorter control sequences moving it relatively are used if possible.
   //
-  mSetCursorPositionString[ROW_OFFSET + 0]    = (CHAR16) ('0' + ((Row + 1) / 10));
-  mSetCursorPositionString[ROW_OFFSET + 1]    = (CHAR16) ('0' + ((Row + 1) % 10));
-  mSetCursorPositionString[COLUMN_OFFSET + 0] = (CHAR16) ('0' + ((Column + 1) / 10));
-  mSetCursorPositionString[COLUMN_OFFSET + 1] = (CHAR16) ('0' + ((Column + 1) % 10));
+  String = MoveCursorString;
+  Count  = 0;
+  if (TerminalDevice->CursorPositionKnown && (Column == 0) && (Mode->CursorRow == (INT32) Row)) {
+    MoveCursorString[0] = CHAR_CARRIAGE_RETURN;
+    MoveCursorString[1] = CHAR_NULL;
+  } else if (TerminalDevice->CursorPositionKnown && (Column == 0) && (Mode->CursorRow + 1 == (INT32) Row)) {
+    MoveCursorString[0] = CHAR_CARRIAGE_RETURN;
+    MoveCursorString[1] = CHAR_LINEFEED;
+    MoveCursorString[2] = CHAR_NULL;
+  } else if (TerminalDevice->CursorPositionKnown && (Mode->CursorRow == (INT32) Row)) {
+    if (Mode->CursorColumn < (INT32) Column) {
+      Count = Column - Mode->CursorColumn;
+      MoveCursorString[0] = 'C';
+    } else {
+      Count = Mode->CursorColumn - Column;
+      MoveCursorString[0] = 'D';
+    }
+  } else if (TerminalDevice->CursorPositionKnown && (Mode->CursorColumn == (INT32) Column)) {
+    if (Mode->CursorRow < (INT32) Row) {
+      Count = Row - Mode->CursorRow;
+      MoveCursorString[0] = 'B';
+    } else {
+      Count = Mode->CursorRow - Row;
+      MoveCursorString[0] = 'A';
+    }
+  } else {
+    mSetCursorPositionString[ROW_OFFSET + 0]    = (CHAR16) ('0' + ((Row + 1) / 10));
+    mSetCursorPositionString[ROW_OFFSET + 1]    = (CHAR16) ('0' + ((Row + 1) % 10));
+    mSetCursorPositionString[COLUMN_OFFSET + 0] = (CHAR16) ('0' + ((Column + 1) / 10));
+    mSetCursorPositionString[COLUMN_OFFSET + 1] = (CHAR16) ('0' + ((Column + 1) % 10));
+    String = mSetCursorPositionString;
+  }
 
-  TerminalDevice->OutputEscChar               = TRUE;
-  Status = This->OutputString (This, mSetCursorPositionString);
+  if (Count != 0) {
+    //
+    // ESC [ Count A/B/C/D
+    //
+    MoveCursorString[6] = CHAR_NULL;
+    MoveCursorString[5] = MoveCursorString[0];
+    String  = &MoveCursorString[5];
+    do {
+      String--;
+      *String = (CHAR16) ('0' + Count % 10);
+      Count   = Count / 10;
+    } while (Count != 0);
+    *(--String) = '[';
+    *(--String) = ESC;
+  }
+
+  TerminalDevice->OutputEscChar = TRUE;
+  Status = This->OutputString (This, String);
   TerminalDevice->OutputEscChar = FALSE;
 
   if (EFI_ERROR (Status)) {
+    TerminalDevice->CursorPositionKnown = FALSE;
     return EFI_DEVICE_ERROR;
   }
   //
@@ -775,6 +876,7 @@ TerminalConOutSetCursorPosition (
   //
   Mode->CursorColumn  = (INT32) Column;
   Mode->CursorRow     = (INT32) Row;
+  TerminalDevice->CursorPositionKnown = TRUE;
 
   return EFI_SUCCESS;
 }
@@ -808,6 +910,74 @@ TerminalConOutEnableCursor (
 }
 
 
+/**
+  Write the bytes collected in the output buffer to the serial device.
+
+  @param  TerminalDevice       The terminal device.
+
+  @retval EFI_SUCCESS          The bytes are written.
+  @retval Others               The serial device fails to write the bytes.
+
+**/
+EFI_STATUS
+TerminalFlushOutput (
+  IN TERMINAL_DEV  *TerminalDevice
+  )
+{
+  UINTN         Length;
+
+  if (TerminalDevice->OutputLength == 0) {
+    return EFI_SUCCESS;
+  }
+
+  Length                       = TerminalDevice->OutputLength;
+  TerminalDevice->OutputLength = 0;
+
+  return TerminalDevice->SerialIo->Write (
+                                     TerminalDevice->SerialIo,
+                                     &Length,
+                                     TerminalDevice->OutputBuffer
+                                     );
+}
+
+
+/**
+  Add bytes to the output buffer, writing the buffer to the serial device
+  first if it is full.
+
+  @param  TerminalDevice       The terminal device.
+  @param  Buffer               The bytes to output.
+  @param  Length               The number of bytes.
+
+  @retval EFI_SUCCESS          The bytes are added to the output buffer.
+  @retval Others               The serial device fails to write the buffer.
+
+**/
+EFI_STATUS
+TerminalBufferOutput (
+  IN TERMINAL_DEV  *TerminalDevice,
+  IN UINT8         *Buffer,
+  IN UINTN         Length
+  )
+{
+  EFI_STATUS    Status;
+
+  ASSERT (Length <= TERMINAL_OUTPUT_BUFFER_SIZE);
+
+  if (TerminalDevice->OutputLength + Length > TERMINAL_OUTPUT_BUFFER_SIZE) {
+    Status = TerminalFlushOutput (TerminalDevice);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  CopyMem (&TerminalDevice->OutputBuffer[TerminalDevice->OutputLength], Buffer, Length);
+  TerminalDevice->OutputLength += Length;
+
+  return EFI_SUCCESS;
+}
+
+
 /**
   Detects if a Unicode char is for Box Drawing text graphics.
 
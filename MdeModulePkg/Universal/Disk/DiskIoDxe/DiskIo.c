@@ -191,6 +191,8 @@ DiskIoDriverBindingStart (
     goto ErrorExit;
   }
 
+  DiskIoCacheInitialize (Instance);
+
   //
   // Install protocol interfaces for the Disk IO device.
   //
@@ -211,6 +213,10 @@ DiskIoDriverBindingStart (
 
 ErrorExit:
   if (EFI_ERROR (Status)) {
+    if (Instance != NULL) {
+      DiskIoCacheFree (Instance);
+    }
+
     if (Instance != NULL && Instance->SharedWorkingBuffer != NULL) {
       FreeAlignedPages (
         Instance->SharedWorkingBuffer,
@@ -322,6 +328,8 @@ DiskIoDriverBindingStop (
       EfiReleaseLock (&Instance->TaskQueueLock);
     } while (!AllTaskDone);
 
+    DiskIoCacheFree (Instance);
+
     FreeAlignedPages (
       Instance->SharedWorkingBuffer,
       EFI_SIZE_TO_PAGES (PcdGet32 (PcdDiskIoDataBufferBlockNum) * Instance->BlockIo->Media->BlockSize)
@@ -845,6 +853,16 @@ DiskIo2ReadWriteDisk (
     return EFI_WRITE_PROTECTED;
   }
 
+  if (Write) {
+    DiskIoCacheInvalidate (Instance, Offset, BufferSize);
+  } else if (Blocking) {
+    Status = DiskIoCacheRead (Instance, MediaId, Offset, BufferSize, Buffer);
+    if (Status != EFI_UNSUPPORTED) {
+      return Status;
+    }
+    Status = EFI_SUCCESS;
+  }
+
   if (Blocking) {
     //
     // Wait till pending async task is completed.
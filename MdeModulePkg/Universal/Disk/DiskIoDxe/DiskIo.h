@@ -30,6 +30,39 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/MemoryAllocationLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 
+//
+// Number of blocks held by one cache line, and the maximum number of lines
+// read ahead when a sequential access pattern is detected.
+//
+#define DISK_IO_CACHE_LINE_BLOCKS       8
+#define DISK_IO_CACHE_READ_AHEAD_LINES  4
+
+#define DISK_IO_CACHE_LINE_SIGNATURE    SIGNATURE_32 ('d', 'i', 'c', 'l')
+typedef struct {
+  UINT32                          Signature;
+  LIST_ENTRY                      Link;     /// < link in the LRU list, most recently used first
+  BOOLEAN                         Valid;
+  EFI_LBA                         Lba;      /// < first block, aligned to DISK_IO_CACHE_LINE_BLOCKS
+  UINT8                           *Data;
+} DISK_IO_CACHE_LINE;
+
+typedef struct {
+  UINTN                           LineNum;  /// < 0 indicates the cache is disabled
+  UINTN                           LineSize;
+  DISK_IO_CACHE_LINE              *Lines;
+  UINT8                           *Buffer;
+  LIST_ENTRY                      LruList;
+  UINT32                          MediaId;
+  EFI_LBA                         NextLba;  /// < line following the last filled one, for sequential detection
+
+  //
+  // Statistics, reported when the driver is stopped
+  //
+  UINT64                          Hits;
+  UINT64                          Misses;
+  UINT64                          ReadAheads;
+} DISK_IO_CACHE;
+
 #define DISK_IO_PRIVATE_DATA_SIGNATURE  SIGNATURE_32 ('d', 's', 'k', 'I')
 typedef struct {
   UINT32                          Signature;
@@ -43,6 +76,8 @@ typedef struct {
 
   EFI_LOCK                        TaskQueueLock;
   LIST_ENTRY                      TaskQueue;
+
+  DISK_IO_CACHE                   Cache;
 } DISK_IO_PRIVATE_DATA;
 #define DISK_IO_PRIVATE_DATA_FROM_DISK_IO(a)  CR (a, DISK_IO_PRIVATE_DATA, DiskIo,  DISK_IO_PRIVATE_DATA_SIGNATURE)
 #define DISK_IO_PRIVATE_DATA_FROM_DISK_IO2(a) CR (a, DISK_IO_PRIVATE_DATA, DiskIo2, DISK_IO_PRIVATE_DATA_SIGNATURE)
@@ -469,5 +504,78 @@ DiskIoComponentNameGetControllerName (
   OUT CHAR16                                          **ControllerName
   );
 
+/**
+  Remove the completed tasks from Instance->TaskQueue. Completed tasks are those who don't have any subtasks.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+
+  @retval TRUE       The Instance->TaskQueue is empty after the completed tasks are removed.
+  @retval FALSE      The Instance->TaskQueue is not empty after the completed tasks are removed.
+**/
+BOOLEAN
+DiskIo2RemoveCompletedTask (
+  IN DISK_IO_PRIVATE_DATA     *Instance
+  );
+
+/**
+  Allocate the block cache of the Disk IO instance.
+
+  The cache is only built on top of physical devices, so that the partitions
+  share the cache of the parent disk and a write through any of them keeps it
+  coherent. Failing to allocate the cache is not fatal; it stays disabled.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+**/
+VOID
+DiskIoCacheInitialize (
+  IN DISK_IO_PRIVATE_DATA     *Instance
+  );
+
+/**
+  Free the block cache of the Disk IO instance and report its statistics.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+**/
+VOID
+DiskIoCacheFree (
+  IN DISK_IO_PRIVATE_DATA     *Instance
+  );
+
+/**
+  Invalidate the cache lines overlapping the specified byte range.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+  @param Offset      The starting byte offset of the range.
+  @param Length      The length in bytes of the range.
+**/
+VOID
+DiskIoCacheInvalidate (
+  IN DISK_IO_PRIVATE_DATA     *Instance,
+  IN UINT64                   Offset,
+  IN UINTN                    Length
+  );
+
+/**
+  Serve a small blocking read through the block cache.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+  @param MediaId     ID of the medium to be read.
+  @param Offset      The starting byte offset on the logical block I/O device to read from.
+  @param BufferSize  The size in bytes of Buffer.
+  @param Buffer      A pointer to the destination buffer for the data.
+
+  @retval EFI_SUCCESS      The data was read from the cache or the device.
+  @retval EFI_UNSUPPORTED  The request cannot be served by the cache and should go to the device directly.
+  @retval EFI_MEDIA_CHANGED The MediaId is not for the current media.
+  @retval others           The device reported an error while filling the cache.
+**/
+EFI_STATUS
+DiskIoCacheRead (
+  IN DISK_IO_PRIVATE_DATA     *Instance,
+  IN UINT32                   MediaId,
+  IN UINT64                   Offset,
+  IN UINTN                    BufferSize,
+  OUT UINT8                   *Buffer
+  );
 
 #endif
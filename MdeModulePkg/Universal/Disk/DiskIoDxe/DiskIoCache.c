@@ -0,0 +1,436 @@
+/** @file
+  Size-bounded LRU block cache of the DiskIo driver.
+
+  Small blocking reads, such as the file system metadata accesses, are served
+  from cache lines of DISK_IO_CACHE_LINE_BLOCKS blocks. A miss on the line that
+  follows the previously filled one is treated as a sequential access, and the
+  next lines are read ahead in the same BlockIo request.
+
+  The cache is write-through: a write invalidates the overlapping lines before
+  it is issued to the device, so nothing is lost if the disk is removed or the
+  system is reset without a flush.
+
+  Only the writes made through this driver are seen by the cache. A client
+  writing the blocks through the raw BlockIo or BlockIo2 protocol of the disk
+  leaves stale lines behind, which are only dropped when the media ID changes
+  or the lines are evicted. The cache is therefore disabled unless the platform
+  sets PcdDiskIoCacheLineNum.
+
+Copyright (c) 2006 - 2014, Intel Corporation. All rights reserved.<BR>
+This program and the accompanying materials
+are licensed and made available under the terms and conditions of the BSD License
+which accompanies this distribution.  The full text of the license may be found at
+http://opensource.org/licenses/bsd-license.php
+
+THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#include "DiskIo.h"
+
+/**
+  Allocate the block cache of the Disk IO instance.
+
+  The cache is only built on top of physical devices, so that the partitions
+  share the cache of the parent disk and a write through any of them keeps it
+  coherent. Removable media are not cached, as a medium swapped without a new
+  media ID would be served stale data. Failing to allocate the cache is not
+  fatal; it stays disabled.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+**/
+VOID
+DiskIoCacheInitialize (
+  IN DISK_IO_PRIVATE_DATA     *Instance
+  )
+{
+  EFI_BLOCK_IO_MEDIA          *Media;
+  DISK_IO_CACHE               *Cache;
+  UINTN                       LineNum;
+  UINTN                       Index;
+
+  Media   = Instance->BlockIo->Media;
+  Cache   = &Instance->Cache;
+  LineNum = PcdGet32 (PcdDiskIoCacheLineNum);
+
+  Cache->LineNum  = 0;
+  Cache->LineSize = DISK_IO_CACHE_LINE_BLOCKS * Media->BlockSize;
+  InitializeListHead (&Cache->LruList);
+
+  if ((LineNum == 0) || (Cache->LineSize == 0) || Media->LogicalPartition || Media->RemovableMedia) {
+    return;
+  }
+
+  if ((Media->IoAlign > 1) && ((Cache->LineSize % Media->IoAlign) != 0)) {
+    return;
+  }
+
+  Cache->Lines  = AllocateZeroPool (LineNum * sizeof (DISK_IO_CACHE_LINE));
+  Cache->Buffer = AllocateAlignedPages (EFI_SIZE_TO_PAGES (LineNum * Cache->LineSize), Media->IoAlign);
+  if ((Cache->Lines == NULL) || (Cache->Buffer == NULL)) {
+    DEBUG ((EFI_D_WARN, "DiskIo: Out of resources, the block cache is disabled.\n"));
+    if (Cache->Lines != NULL) {
+      FreePool (Cache->Lines);
+      Cache->Lines = NULL;
+    }
+    if (Cache->Buffer != NULL) {
+      FreeAlignedPages (Cache->Buffer, EFI_SIZE_TO_PAGES (LineNum * Cache->LineSize));
+      Cache->Buffer = NULL;
+    }
+    return;
+  }
+
+  for (Index = 0; Index < LineNum; Index++) {
+    Cache->Lines[Index].Signature = DISK_IO_CACHE_LINE_SIGNATURE;
+    Cache->Lines[Index].Valid     = FALSE;
+    Cache->Lines[Index].Data      = Cache->Buffer + Index * Cache->LineSize;
+    InsertTailList (&Cache->LruList, &Cache->Lines[Index].Link);
+  }
+
+  Cache->LineNum = LineNum;
+  Cache->MediaId = Media->MediaId;
+  Cache->NextLba = 0;
+}
+
+/**
+  Free the block cache of the Disk IO instance and report its statistics.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+**/
+VOID
+DiskIoCacheFree (
+  IN DISK_IO_PRIVATE_DATA     *Instance
+  )
+{
+  DISK_IO_CACHE               *Cache;
+
+  Cache = &Instance->Cache;
+  if (Cache->LineNum == 0) {
+    return;
+  }
+
+  if (Cache->Hits + Cache->Misses != 0) {
+    DEBUG ((
+      EFI_D_INFO,
+      "DiskIo: Cache hits/misses = %ld/%ld (%ld%%), %ld lines read ahead\n",
+      Cache->Hits,
+      Cache->Misses,
+      DivU64x64Remainder (MultU64x32 (Cache->Hits, 100), Cache->Hits + Cache->Misses, NULL),
+      Cache->ReadAheads
+      ));
+  }
+
+  FreeAlignedPages (Cache->Buffer, EFI_SIZE_TO_PAGES (Cache->LineNum * Cache->LineSize));
+  FreePool (Cache->Lines);
+  Cache->Buffer  = NULL;
+  Cache->Lines   = NULL;
+  Cache->LineNum = 0;
+}
+
+/**
+  Invalidate all the cache lines.
+
+  @param Cache       Pointer to the DISK_IO_CACHE.
+**/
+VOID
+DiskIoCacheInvalidateAll (
+  IN DISK_IO_CACHE            *Cache
+  )
+{
+  UINTN                       Index;
+
+  for (Index = 0; Index < Cache->LineNum; Index++) {
+    Cache->Lines[Index].Valid = FALSE;
+  }
+  Cache->NextLba = 0;
+}
+
+/**
+  Invalidate the cache lines overlapping the specified byte range.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+  @param Offset      The starting byte offset of the range.
+  @param Length      The length in bytes of the range.
+**/
+VOID
+DiskIoCacheInvalidate (
+  IN DISK_IO_PRIVATE_DATA     *Instance,
+  IN UINT64                   Offset,
+  IN UINTN                    Length
+  )
+{
+  DISK_IO_CACHE               *Cache;
+  EFI_BLOCK_IO_MEDIA          *Media;
+  DISK_IO_CACHE_LINE          *Line;
+  EFI_LBA                     Lba;
+  EFI_LBA                     LastLba;
+  UINTN                       Index;
+  EFI_TPL                     OldTpl;
+
+  Cache = &Instance->Cache;
+  Media = Instance->BlockIo->Media;
+  if ((Cache->LineNum == 0) || (Length == 0)) {
+    return;
+  }
+
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+
+  if (Cache->LineSize != DISK_IO_CACHE_LINE_BLOCKS * Media->BlockSize) {
+    //
+    // The block size changed with the media, the lines cannot be located any more.
+    //
+    DiskIoCacheInvalidateAll (Cache);
+  } else {
+    Lba     = DivU64x32 (Offset, Media->BlockSize);
+    LastLba = DivU64x32 (Offset + Length - 1, Media->BlockSize);
+    for (Index = 0; Index < Cache->LineNum; Index++) {
+      Line = &Cache->Lines[Index];
+      if (Line->Valid && (Line->Lba <= LastLba) && (Line->Lba + DISK_IO_CACHE_LINE_BLOCKS > Lba)) {
+        //
+        // Keep the invalid lines at the tail of the LRU list so they are reused first.
+        //
+        Line->Valid = FALSE;
+        RemoveEntryList (&Line->Link);
+        InsertTailList (&Cache->LruList, &Line->Link);
+      }
+    }
+  }
+
+  gBS->RestoreTPL (OldTpl);
+}
+
+/**
+  Find the valid cache line starting at the specified block.
+
+  @param Cache       Pointer to the DISK_IO_CACHE.
+  @param Lba         The first block of the line.
+
+  @return The cache line, or NULL if the line is not cached.
+**/
+DISK_IO_CACHE_LINE *
+DiskIoCacheLookup (
+  IN DISK_IO_CACHE            *Cache,
+  IN EFI_LBA                  Lba
+  )
+{
+  LIST_ENTRY                  *Link;
+  DISK_IO_CACHE_LINE          *Line;
+
+  for ( Link = GetFirstNode (&Cache->LruList)
+      ; !IsNull (&Cache->LruList, Link)
+      ; Link = GetNextNode (&Cache->LruList, Link)
+      ) {
+    Line = CR (Link, DISK_IO_CACHE_LINE, Link, DISK_IO_CACHE_LINE_SIGNATURE);
+    if (!Line->Valid) {
+      //
+      // All the following lines are invalid as well.
+      //
+      break;
+    }
+    if (Line->Lba == Lba) {
+      return Line;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Read the specified line from the device into the least recently used line,
+  reading the following lines ahead when the access is sequential.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+  @param MediaId     ID of the medium to be read.
+  @param Lba         The first block of the line.
+  @param Line        Return the filled cache line.
+
+  @retval EFI_SUCCESS  The line is filled.
+  @retval others       The device reported an error.
+**/
+EFI_STATUS
+DiskIoCacheFill (
+  IN DISK_IO_PRIVATE_DATA     *Instance,
+  IN UINT32                   MediaId,
+  IN EFI_LBA                  Lba,
+  OUT DISK_IO_CACHE_LINE      **Line
+  )
+{
+  EFI_STATUS                  Status;
+  DISK_IO_CACHE               *Cache;
+  EFI_BLOCK_IO_MEDIA          *Media;
+  DISK_IO_CACHE_LINE          *Victim;
+  EFI_LBA                     NextLba;
+  UINT8                       *ReadBuffer;
+  UINTN                       LineCount;
+  UINTN                       MaxLineCount;
+  UINTN                       Index;
+
+  Cache     = &Instance->Cache;
+  Media     = Instance->BlockIo->Media;
+  LineCount = 1;
+
+  if (Lba == Cache->NextLba) {
+    //
+    // Sequential access: read ahead the following lines which are not cached yet,
+    // within the shared working buffer and half of the cache.
+    //
+    MaxLineCount = MIN (DISK_IO_CACHE_READ_AHEAD_LINES, Cache->LineNum / 2) + 1;
+    MaxLineCount = MIN (MaxLineCount, PcdGet32 (PcdDiskIoDataBufferBlockNum) / DISK_IO_CACHE_LINE_BLOCKS);
+    while (LineCount < MaxLineCount) {
+      NextLba = Lba + LineCount * DISK_IO_CACHE_LINE_BLOCKS;
+      if ((NextLba + DISK_IO_CACHE_LINE_BLOCKS - 1 > Media->LastBlock) ||
+          (DiskIoCacheLookup (Cache, NextLba) != NULL)) {
+        break;
+      }
+      LineCount++;
+    }
+  }
+
+  if (LineCount == 1) {
+    Victim     = CR (Cache->LruList.BackLink, DISK_IO_CACHE_LINE, Link, DISK_IO_CACHE_LINE_SIGNATURE);
+    ReadBuffer = Victim->Data;
+  } else {
+    ReadBuffer = Instance->SharedWorkingBuffer;
+  }
+
+  Status = Instance->BlockIo->ReadBlocks (
+                                Instance->BlockIo,
+                                MediaId,
+                                Lba,
+                                LineCount * Cache->LineSize,
+                                ReadBuffer
+                                );
+  if (EFI_ERROR (Status)) {
+    DiskIoCacheInvalidateAll (Cache);
+    return Status;
+  }
+
+  Cache->Misses++;
+  Cache->ReadAheads += LineCount - 1;
+  Cache->NextLba     = Lba + LineCount * DISK_IO_CACHE_LINE_BLOCKS;
+
+  //
+  // Insert the lines in reverse order so that the requested one ends up most recently used.
+  //
+  for (Index = LineCount; Index > 0; Index--) {
+    Victim = CR (Cache->LruList.BackLink, DISK_IO_CACHE_LINE, Link, DISK_IO_CACHE_LINE_SIGNATURE);
+    if (ReadBuffer != Victim->Data) {
+      CopyMem (Victim->Data, ReadBuffer + (Index - 1) * Cache->LineSize, Cache->LineSize);
+    }
+    Victim->Lba   = Lba + (Index - 1) * DISK_IO_CACHE_LINE_BLOCKS;
+    Victim->Valid = TRUE;
+    RemoveEntryList (&Victim->Link);
+    InsertHeadList (&Cache->LruList, &Victim->Link);
+  }
+
+  *Line = Victim;
+  return EFI_SUCCESS;
+}
+
+/**
+  Serve a small blocking read through the block cache.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+  @param MediaId     ID of the medium to be read.
+  @param Offset      The starting byte offset on the logical block I/O device to read from.
+  @param BufferSize  The size in bytes of Buffer.
+  @param Buffer      A pointer to the destination buffer for the data.
+
+  @retval EFI_SUCCESS      The data was read from the cache or the device.
+  @retval EFI_UNSUPPORTED  The request cannot be served by the cache and should go to the device directly.
+  @retval EFI_MEDIA_CHANGED The MediaId is not for the current media.
+  @retval others           The device reported an error while filling the cache.
+**/
+EFI_STATUS
+DiskIoCacheRead (
+  IN DISK_IO_PRIVATE_DATA     *Instance,
+  IN UINT32                   MediaId,
+  IN UINT64                   Offset,
+  IN UINTN                    BufferSize,
+  OUT UINT8                   *Buffer
+  )
+{
+  EFI_STATUS                  Status;
+  DISK_IO_CACHE               *Cache;
+  EFI_BLOCK_IO_MEDIA          *Media;
+  DISK_IO_CACHE_LINE          *Line;
+  EFI_LBA                     Lba;
+  EFI_LBA                     LastLba;
+  UINTN                       LineOffset;
+  UINTN                       Length;
+  EFI_TPL                     OldTpl;
+
+  Cache = &Instance->Cache;
+  Media = Instance->BlockIo->Media;
+
+  //
+  // Only the small requests are cached; large ones gain nothing from an extra copy.
+  // The media reported by the device may have changed since the cache was built.
+  //
+  if ((Cache->LineNum == 0) || (BufferSize == 0) || (BufferSize > Cache->LineSize) ||
+      Media->LogicalPartition || Media->RemovableMedia ||
+      (Cache->LineSize != DISK_IO_CACHE_LINE_BLOCKS * Media->BlockSize)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Leave the requests touching the partial line at the end of the media to the device.
+  //
+  LastLba = DivU64x32 (Offset + BufferSize - 1, Media->BlockSize);
+  if ((LastLba | (DISK_IO_CACHE_LINE_BLOCKS - 1)) > Media->LastBlock) {
+    return EFI_UNSUPPORTED;
+  }
+
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+
+  //
+  // The pending non-blocking writes may change the blocks while a line is being filled.
+  //
+  if (!DiskIo2RemoveCompletedTask (Instance)) {
+    gBS->RestoreTPL (OldTpl);
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // A line must not be served for a medium other than the one in the device.
+  //
+  if (MediaId != Media->MediaId) {
+    gBS->RestoreTPL (OldTpl);
+    return EFI_MEDIA_CHANGED;
+  }
+
+  if (Cache->MediaId != MediaId) {
+    DiskIoCacheInvalidateAll (Cache);
+    Cache->MediaId = MediaId;
+  }
+
+  Lba        = DivU64x32 (Offset, Media->BlockSize) & ~((UINT64) DISK_IO_CACHE_LINE_BLOCKS - 1);
+  LineOffset = (UINTN) (Offset - MultU64x32 (Lba, Media->BlockSize));
+  Status     = EFI_SUCCESS;
+
+  while (BufferSize > 0) {
+    Line = DiskIoCacheLookup (Cache, Lba);
+    if (Line != NULL) {
+      Cache->Hits++;
+      RemoveEntryList (&Line->Link);
+      InsertHeadList (&Cache->LruList, &Line->Link);
+    } else {
+      Status = DiskIoCacheFill (Instance, MediaId, Lba, &Line);
+      if (EFI_ERROR (Status)) {
+        break;
+      }
+    }
+
+    Length = MIN (BufferSize, Cache->LineSize - LineOffset);
+    CopyMem (Buffer, Line->Data + LineOffset, Length);
+
+    Buffer     += Length;
+    BufferSize -= Length;
+    LineOffset  = 0;
+    Lba        += DISK_IO_CACHE_LINE_BLOCKS;
+  }
+
+  gBS->RestoreTPL (OldTpl);
+  return Status;
+}
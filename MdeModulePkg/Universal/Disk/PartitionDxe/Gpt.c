@@ -245,13 +245,13 @@ PartitionInstallGptChildHandles (
   //
   // Read the Protective MBR from LBA #0
   //
-  Status = DiskIo->ReadDisk (
-                     DiskIo,
-                     MediaId,
-                     0,
-                     BlockSize,
-                     ProtectiveMbr
-                     );
+  Status = PartitionProbeReadDisk (
+             DiskIo,
+             MediaId,
+             0,
+             BlockSize,
+             ProtectiveMbr
+             );
   if (EFI_ERROR (Status)) {
     GptValidStatus = Status;
     goto Done;
@@ -329,13 +329,13 @@ PartitionInstallGptChildHandles (
     goto Done;
   }
 
-  Status = DiskIo->ReadDisk (
-                     DiskIo,
-                     MediaId,
-                     MultU64x32(PrimaryHeader->PartitionEntryLBA, BlockSize),
-                     PrimaryHeader->NumberOfPartitionEntries * (PrimaryHeader->SizeOfPartitionEntry),
-                     PartEntry
-                     );
+  Status = PartitionProbeReadDisk (
+             DiskIo,
+             MediaId,
+             MultU64x32(PrimaryHeader->PartitionEntryLBA, BlockSize),
+             PrimaryHeader->NumberOfPartitionEntries * (PrimaryHeader->SizeOfPartitionEntry),
+             PartEntry
+             );
   if (EFI_ERROR (Status)) {
     GptValidStatus = Status;
     DEBUG ((EFI_D_ERROR, " Partition Entry ReadDisk error\n"));
@@ -476,13 +476,13 @@ PartitionValidGptTable (
   //
   // Read the EFI Partition Table Header
   //
-  Status = DiskIo->ReadDisk (
-                     DiskIo,
-                     MediaId,
-                     MultU64x32 (Lba, BlockSize),
-                     BlockSize,
-                     PartHdr
-                     );
+  Status = PartitionProbeReadDisk (
+             DiskIo,
+             MediaId,
+             MultU64x32 (Lba, BlockSize),
+             BlockSize,
+             PartHdr
+             );
   if (EFI_ERROR (Status)) {
     FreePool (PartHdr);
     return FALSE;
@@ -550,13 +550,13 @@ PartitionCheckGptEntryArrayCRC (
     return FALSE;
   }
 
-  Status = DiskIo->ReadDisk (
-                    DiskIo,
-                    BlockIo->Media->MediaId,
-                    MultU64x32(PartHeader->PartitionEntryLBA, BlockIo->Media->BlockSize),
-                    PartHeader->NumberOfPartitionEntries * PartHeader->SizeOfPartitionEntry,
-                    Ptr
-                    );
+  Status = PartitionProbeReadDisk (
+             DiskIo,
+             BlockIo->Media->MediaId,
+             MultU64x32(PartHeader->PartitionEntryLBA, BlockIo->Media->BlockSize),
+             PartHeader->NumberOfPartitionEntries * PartHeader->SizeOfPartitionEntry,
+             Ptr
+             );
   if (EFI_ERROR (Status)) {
     FreePool (Ptr);
     return FALSE;
@@ -634,6 +634,10 @@ PartitionRestoreGptTable (
                      BlockSize,
                      PartHdr
                      );
+  //
+  // The probe buffer may hold the blocks that were just written.
+  //
+  PartitionProbeInvalidate (DiskIo);
   if (EFI_ERROR (Status)) {
     goto Done;
   }
@@ -645,13 +649,13 @@ PartitionRestoreGptTable (
     goto Done;
   }
 
-  Status = DiskIo->ReadDisk (
-                    DiskIo,
-                    MediaId,
-                    MultU64x32(PartHeader->PartitionEntryLBA, (UINT32) BlockSize),
-                    PartHeader->NumberOfPartitionEntries * PartHeader->SizeOfPartitionEntry,
-                    Ptr
-                    );
+  Status = PartitionProbeReadDisk (
+             DiskIo,
+             MediaId,
+             MultU64x32(PartHeader->PartitionEntryLBA, (UINT32) BlockSize),
+             PartHeader->NumberOfPartitionEntries * PartHeader->SizeOfPartitionEntry,
+             Ptr
+             );
   if (EFI_ERROR (Status)) {
     goto Done;
   }
@@ -663,6 +667,7 @@ PartitionRestoreGptTable (
                     PartHeader->NumberOfPartitionEntries * PartHeader->SizeOfPartitionEntry,
                     Ptr
                     );
+  PartitionProbeInvalidate (DiskIo);
 
 Done:
   FreePool (PartHdr);
@@ -48,6 +48,11 @@ PARTITION_DETECT_ROUTINE mPartitionDetectRoutineTable[] = {
   NULL
 };
 
+//
+// Probe buffer of the disk whose partition tables are being detected.
+//
+PARTITION_PROBE_BUFFER   *mPartitionProbe = NULL;
+
 /**
   Test to see if this driver supports ControllerHandle. Any ControllerHandle
   than contains a BlockIo and DiskIo protocol or a BlockIo2 protocol can be
@@ -200,6 +205,7 @@ PartitionDriverBindingStart (
   EFI_DISK_IO2_PROTOCOL     *DiskIo2;
   EFI_DEVICE_PATH_PROTOCOL  *ParentDevicePath;
   PARTITION_DETECT_ROUTINE  *Routine;
+  PARTITION_PROBE_BUFFER    Probe;
   BOOLEAN                   MediaPresent;
   EFI_TPL                   OldTpl;
 
@@ -307,8 +313,10 @@ PartitionDriverBindingStart (
     //
     // Try for GPT, then El Torito, and then legacy MBR partition types. If the
     // media supports a given partition type install child handles to represent
-    // the partitions described by the media.
+    // the partitions described by the media. The detect routines share the
+    // reads of the first and the last blocks of the disk.
     //
+    PartitionProbeBegin (&Probe, DiskIo, BlockIo->Media);
     Routine = &mPartitionDetectRoutineTable[0];
     while (*Routine != NULL) {
       Status = (*Routine) (
@@ -325,6 +333,7 @@ PartitionDriverBindingStart (
       }
       Routine++;
     }
+    PartitionProbeEnd (&Probe);
   }
   //
   // In the case that the driver is already started (OpenStatus == EFI_ALREADY_STARTED),
@@ -591,6 +600,175 @@ ProbeMediaStatus (
   return DefaultStatus;
 }
 
+/**
+  Start sharing the partition metadata reads on the parent disk across the
+  detect routines.
+
+  The probe buffer has a window at the start and a window at the end of the
+  disk. Each window is read in one DiskIo request the first time a detect
+  routine reads inside it, so the protective MBR, the GPT header and entry
+  array, and the MBR or El Torito descriptors all come from the same request
+  instead of one request per structure per routine.
+
+  @param[out] Probe    The probe buffer to initialize.
+  @param[in]  DiskIo   Parent DiskIo interface.
+  @param[in]  Media    Parent BlockIo media.
+
+**/
+VOID
+PartitionProbeBegin (
+  OUT PARTITION_PROBE_BUFFER       *Probe,
+  IN  EFI_DISK_IO_PROTOCOL         *DiskIo,
+  IN  EFI_BLOCK_IO_MEDIA           *Media
+  )
+{
+  UINT64                           MediaSize;
+  UINTN                            WindowSize;
+
+  ZeroMem (Probe, sizeof (PARTITION_PROBE_BUFFER));
+  Probe->Previous = mPartitionProbe;
+  Probe->DiskIo   = DiskIo;
+  Probe->MediaId  = Media->MediaId;
+  mPartitionProbe = Probe;
+
+  if (!Media->MediaPresent || (Media->BlockSize == 0) || (Media->BlockSize > PARTITION_PROBE_WINDOW_SIZE)) {
+    return;
+  }
+
+  MediaSize  = MultU64x32 (Media->LastBlock + 1, Media->BlockSize);
+  WindowSize = PARTITION_PROBE_WINDOW_SIZE - (PARTITION_PROBE_WINDOW_SIZE % Media->BlockSize);
+  if (WindowSize > MediaSize) {
+    WindowSize = (UINTN) MediaSize;
+  }
+
+  Probe->Window[PARTITION_PROBE_HEAD].Offset = 0;
+  Probe->Window[PARTITION_PROBE_HEAD].Size   = WindowSize;
+  Probe->Window[PARTITION_PROBE_TAIL].Offset = MediaSize - WindowSize;
+  Probe->Window[PARTITION_PROBE_TAIL].Size   = WindowSize;
+}
+
+/**
+  Free the windows of the probe buffer.
+
+  @param[in]  Probe    The probe buffer.
+
+**/
+VOID
+PartitionProbeFreeWindows (
+  IN  PARTITION_PROBE_BUFFER       *Probe
+  )
+{
+  UINTN                            Index;
+
+  for (Index = 0; Index < sizeof (Probe->Window) / sizeof (Probe->Window[0]); Index++) {
+    if (Probe->Window[Index].Buffer != NULL) {
+      FreePool (Probe->Window[Index].Buffer);
+      Probe->Window[Index].Buffer = NULL;
+    }
+    Probe->Window[Index].Tried = FALSE;
+  }
+}
+
+/**
+  Stop sharing the partition metadata reads and free the probe buffer.
+
+  @param[in]  Probe    The probe buffer initialized by PartitionProbeBegin().
+
+**/
+VOID
+PartitionProbeEnd (
+  IN  PARTITION_PROBE_BUFFER       *Probe
+  )
+{
+  PartitionProbeFreeWindows (Probe);
+
+  ASSERT (mPartitionProbe == Probe);
+  mPartitionProbe = Probe->Previous;
+}
+
+/**
+  Read partition metadata from the parent disk. The read is served from the
+  probe buffer when it falls in the first or the last PARTITION_PROBE_WINDOW_SIZE
+  bytes of the disk being probed, otherwise it is passed to DiskIo.
+
+  A window that cannot be read as a whole, for instance because of a bad
+  block, is not retried; the reads inside it are then passed to DiskIo so that
+  the detect routines see the same status as without the probe buffer.
+
+  @param[in]  DiskIo      Parent DiskIo interface.
+  @param[in]  MediaId     Id of the media, changes every time the media is replaced.
+  @param[in]  Offset      The starting byte offset to read from.
+  @param[in]  BufferSize  Size of Buffer.
+  @param[out] Buffer      Buffer containing read data.
+
+  @retval EFI_SUCCESS     The data was read correctly from the device.
+  @retval others          The status returned by DiskIo->ReadDisk().
+
+**/
+EFI_STATUS
+PartitionProbeReadDisk (
+  IN  EFI_DISK_IO_PROTOCOL         *DiskIo,
+  IN  UINT32                       MediaId,
+  IN  UINT64                       Offset,
+  IN  UINTN                        BufferSize,
+  OUT VOID                         *Buffer
+  )
+{
+  EFI_STATUS                       Status;
+  PARTITION_PROBE_BUFFER           *Probe;
+  PARTITION_PROBE_WINDOW           *Window;
+  UINTN                            Index;
+
+  Probe = mPartitionProbe;
+  if ((Probe != NULL) && (Probe->DiskIo == DiskIo) && (Probe->MediaId == MediaId)) {
+    for (Index = 0; Index < sizeof (Probe->Window) / sizeof (Probe->Window[0]); Index++) {
+      Window = &Probe->Window[Index];
+      if ((Window->Size == 0) ||
+          (Offset < Window->Offset) ||
+          (BufferSize > Window->Size) ||
+          (Offset - Window->Offset > Window->Size - BufferSize)) {
+        continue;
+      }
+
+      if ((Window->Buffer == NULL) && !Window->Tried) {
+        Window->Tried  = TRUE;
+        Window->Buffer = AllocatePool (Window->Size);
+        if (Window->Buffer != NULL) {
+          Status = DiskIo->ReadDisk (DiskIo, MediaId, Window->Offset, Window->Size, Window->Buffer);
+          if (EFI_ERROR (Status)) {
+            FreePool (Window->Buffer);
+            Window->Buffer = NULL;
+          }
+        }
+      }
+
+      if (Window->Buffer != NULL) {
+        CopyMem (Buffer, Window->Buffer + (UINTN) (Offset - Window->Offset), BufferSize);
+        return EFI_SUCCESS;
+      }
+    }
+  }
+
+  return DiskIo->ReadDisk (DiskIo, MediaId, Offset, BufferSize, Buffer);
+}
+
+/**
+  Drop the probe buffer of the parent disk after its metadata is written.
+  The windows are read again on the next access.
+
+  @param[in]  DiskIo   Parent DiskIo interface.
+
+**/
+VOID
+PartitionProbeInvalidate (
+  IN  EFI_DISK_IO_PROTOCOL         *DiskIo
+  )
+{
+  if ((mPartitionProbe != NULL) && (mPartitionProbe->DiskIo == DiskIo)) {
+    PartitionProbeFreeWindows (mPartitionProbe);
+  }
+}
+
 /**
   Read by using the Disk IO protocol on the parent device. Lba addresses
   must be converted to byte offsets.
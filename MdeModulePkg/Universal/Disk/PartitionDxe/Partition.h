@@ -74,6 +74,35 @@ typedef struct {
 #define PARTITION_DEVICE_FROM_BLOCK_IO_THIS(a)  CR (a, PARTITION_PRIVATE_DATA, BlockIo, PARTITION_PRIVATE_DATA_SIGNATURE)
 #define PARTITION_DEVICE_FROM_BLOCK_IO2_THIS(a) CR (a, PARTITION_PRIVATE_DATA, BlockIo2, PARTITION_PRIVATE_DATA_SIGNATURE)
 
+//
+// Size of the regions at the start and at the end of the disk that are read
+// in one request while the partition tables are probed. 64KB covers the
+// protective MBR, the GPT header and a 128-entry array for up to 4KB blocks
+// at both ends, as well as the first ISO-9660 volume descriptors.
+//
+#define PARTITION_PROBE_WINDOW_SIZE  SIZE_64KB
+
+typedef struct {
+  UINT64                    Offset;
+  UINTN                     Size;
+  UINT8                     *Buffer;
+  BOOLEAN                   Tried;
+} PARTITION_PROBE_WINDOW;
+
+#define PARTITION_PROBE_HEAD  0
+#define PARTITION_PROBE_TAIL  1
+
+//
+// Partition metadata read during probing, shared by the detect routines.
+//
+typedef struct _PARTITION_PROBE_BUFFER PARTITION_PROBE_BUFFER;
+struct _PARTITION_PROBE_BUFFER {
+  PARTITION_PROBE_BUFFER    *Previous;
+  EFI_DISK_IO_PROTOCOL      *DiskIo;
+  UINT32                    MediaId;
+  PARTITION_PROBE_WINDOW    Window[2];
+};
+
 //
 // Global Variables
 //
@@ -428,6 +457,68 @@ PartitionInstallMbrChildHandles (
   IN  EFI_DEVICE_PATH_PROTOCOL     *DevicePath
   );
 
+/**
+  Start sharing the partition metadata reads on the parent disk across the
+  detect routines.
+
+  @param[out] Probe    The probe buffer to initialize.
+  @param[in]  DiskIo   Parent DiskIo interface.
+  @param[in]  Media    Parent BlockIo media.
+
+**/
+VOID
+PartitionProbeBegin (
+  OUT PARTITION_PROBE_BUFFER       *Probe,
+  IN  EFI_DISK_IO_PROTOCOL         *DiskIo,
+  IN  EFI_BLOCK_IO_MEDIA           *Media
+  );
+
+/**
+  Stop sharing the partition metadata reads and free the probe buffer.
+
+  @param[in]  Probe    The probe buffer initialized by PartitionProbeBegin().
+
+**/
+VOID
+PartitionProbeEnd (
+  IN  PARTITION_PROBE_BUFFER       *Probe
+  );
+
+/**
+  Read partition metadata from the parent disk. The read is served from the
+  probe buffer when it falls in the first or the last PARTITION_PROBE_WINDOW_SIZE
+  bytes of the disk being probed, otherwise it is passed to DiskIo.
+
+  @param[in]  DiskIo      Parent DiskIo interface.
+  @param[in]  MediaId     Id of the media, changes every time the media is replaced.
+  @param[in]  Offset      The starting byte offset to read from.
+  @param[in]  BufferSize  Size of Buffer.
+  @param[out] Buffer      Buffer containing read data.
+
+  @retval EFI_SUCCESS     The data was read correctly from the device.
+  @retval others          The status returned by DiskIo->ReadDisk().
+
+**/
+EFI_STATUS
+PartitionProbeReadDisk (
+  IN  EFI_DISK_IO_PROTOCOL         *DiskIo,
+  IN  UINT32                       MediaId,
+  IN  UINT64                       Offset,
+  IN  UINTN                        BufferSize,
+  OUT VOID                         *Buffer
+  );
+
+/**
+  Drop the probe buffer of the parent disk after its metadata is written.
+
+  @param[in]  DiskIo   Parent DiskIo interface.
+
+**/
+VOID
+PartitionProbeInvalidate (
+  IN  EFI_DISK_IO_PROTOCOL         *DiskIo
+  );
+
 typedef
 EFI_STATUS
 (*PARTITION_DETECT_ROUTINE) (
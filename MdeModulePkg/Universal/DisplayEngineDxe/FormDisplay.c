@@ -3973,6 +3973,11 @@ FormDisplay (
   gUserInput = UserInputData;
   gFormData  = FormData;
 
+  //
+  // Keep sending only the changed text to the console until ExitDisplay().
+  //
+  ScreenBufferInstall ();
+
   //
   // Process the status info first.
   //
@@ -4043,6 +4048,7 @@ DriverClearDisplayPage (
   VOID
   )
 {
+  ScreenBufferUninstall ();
   ClearDisplayPage ();
   mIsFirstForm = TRUE;
 }
@@ -4161,6 +4167,8 @@ UnloadDisplayEngine (
 
   FreeDisplayStrings ();
 
+  ScreenBufferFree ();
+
   if (gHighligthMenuInfo.HLTOpCode != NULL) {
     FreePool (gHighligthMenuInfo.HLTOpCode);
   }
@@ -0,0 +1,604 @@
+/** @file
+Screen buffer used while the forms are shown. It keeps a copy of the characters
+and attributes on the console, and only sends the changed text to the console.
+
+Copyright (c) 2016, Intel Corporation. All rights reserved.<BR>
+This program and the accompanying materials
+are licensed and made available under the terms and conditions of the BSD License
+which accompanies this distribution.  The full text of the license may be found at
+http://opensource.org/licenses/bsd-license.php
+
+THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#include "FormDisplay.h"
+
+SCREEN_BUFFER  mScreenBuffer = {
+  {
+    ScreenBufferReset,
+    ScreenBufferOutputString,
+    ScreenBufferTestString,
+    ScreenBufferQueryMode,
+    ScreenBufferSetMode,
+    ScreenBufferSetAttribute,
+    ScreenBufferClearScreen,
+    ScreenBufferSetCursorPosition,
+    ScreenBufferEnableCursor,
+    NULL
+  }
+};
+
+/**
+  Mark the cells of the screen buffer as unknown, so that the text written to
+  them next is always sent to the console.
+
+  @param  Start                  Index of the first cell.
+  @param  Count                  Number of cells.
+
+**/
+VOID
+ScreenBufferInvalidate (
+  IN UINTN                            Start,
+  IN UINTN                            Count
+  )
+{
+  ZeroMem (&mScreenBuffer.Cells[Start], Count * sizeof (SCREEN_BUFFER_CELL));
+}
+
+/**
+  Update the screen buffer after the console mode is changed.
+
+  @retval EFI_SUCCESS            The screen buffer matches the console mode.
+  @retval EFI_OUT_OF_RESOURCES   No enough memory for the screen buffer.
+  @retval Others                 The console mode cannot be queried.
+
+**/
+EFI_STATUS
+ScreenBufferUpdateMode (
+  VOID
+  )
+{
+  EFI_STATUS                          Status;
+  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL     *ConOut;
+  UINTN                               Columns;
+  UINTN                               Rows;
+
+  ConOut = mScreenBuffer.ConOut;
+  CopyMem (&mScreenBuffer.TextOutMode, ConOut->Mode, sizeof (EFI_SIMPLE_TEXT_OUTPUT_MODE));
+
+  Status = ConOut->QueryMode (ConOut, ConOut->Mode->Mode, &Columns, &Rows);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if ((Columns != mScreenBuffer.Columns) || (Rows != mScreenBuffer.Rows)) {
+    if (mScreenBuffer.Cells != NULL) {
+      FreePool (mScreenBuffer.Cells);
+    }
+    if (mScreenBuffer.LineBuffer != NULL) {
+      FreePool (mScreenBuffer.LineBuffer);
+    }
+    mScreenBuffer.Columns    = 0;
+    mScreenBuffer.Rows       = 0;
+    mScreenBuffer.Cells      = AllocatePool (Columns * Rows * sizeof (SCREEN_BUFFER_CELL));
+    mScreenBuffer.LineBuffer = AllocatePool ((Columns + 1) * sizeof (CHAR16));
+    if ((mScreenBuffer.Cells == NULL) || (mScreenBuffer.LineBuffer == NULL)) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+    mScreenBuffer.Columns = Columns;
+    mScreenBuffer.Rows    = Rows;
+  }
+
+  ScreenBufferInvalidate (0, Columns * Rows);
+  return EFI_SUCCESS;
+}
+
+/**
+  Send the cursor position and attribute of the screen buffer to the console,
+  if they are different.
+
+**/
+VOID
+ScreenBufferSyncConsole (
+  VOID
+  )
+{
+  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL     *ConOut;
+  EFI_SIMPLE_TEXT_OUTPUT_MODE         *Mode;
+
+  ConOut = mScreenBuffer.ConOut;
+  Mode   = &mScreenBuffer.TextOutMode;
+
+  if (ConOut->Mode->Attribute != Mode->Attribute) {
+    ConOut->SetAttribute (ConOut, (UINTN) Mode->Attribute);
+  }
+
+  if ((ConOut->Mode->CursorColumn != Mode->CursorColumn) || (ConOut->Mode->CursorRow != Mode->CursorRow)) {
+    ConOut->SetCursorPosition (ConOut, (UINTN) Mode->CursorColumn, (UINTN) Mode->CursorRow);
+  }
+}
+
+/**
+  Install the screen buffer as the console output of the system table, so that
+  all text written while the forms are shown goes through it.
+
+  The screen buffer is only used when PcdBrowserScreenBufferEnable is TRUE.
+
+**/
+VOID
+ScreenBufferInstall (
+  VOID
+  )
+{
+  EFI_STATUS                          Status;
+
+  if (!FeaturePcdGet (PcdBrowserScreenBufferEnable) || mScreenBuffer.Installed || (gST->ConOut == NULL)) {
+    return;
+  }
+
+  mScreenBuffer.ConOut = gST->ConOut;
+  Status = ScreenBufferUpdateMode ();
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  mScreenBuffer.TextOut.Mode = &mScreenBuffer.TextOutMode;
+  mScreenBuffer.Installed    = TRUE;
+
+  gST->ConOut = &mScreenBuffer.TextOut;
+  gST->Hdr.CRC32 = 0;
+  gBS->CalculateCrc32 (
+        (UINT8 *) &gST->Hdr,
+        gST->Hdr.HeaderSize,
+        &gST->Hdr.CRC32
+        );
+}
+
+/**
+  Restore the console output of the system table.
+
+**/
+VOID
+ScreenBufferUninstall (
+  VOID
+  )
+{
+  if (!mScreenBuffer.Installed) {
+    return;
+  }
+
+  mScreenBuffer.Installed = FALSE;
+  ScreenBufferSyncConsole ();
+
+  if (gST->ConOut == &mScreenBuffer.TextOut) {
+    gST->ConOut = mScreenBuffer.ConOut;
+    gST->Hdr.CRC32 = 0;
+    gBS->CalculateCrc32 (
+          (UINT8 *) &gST->Hdr,
+          gST->Hdr.HeaderSize,
+          &gST->Hdr.CRC32
+          );
+  }
+}
+
+/**
+  Free the screen buffer.
+
+**/
+VOID
+ScreenBufferFree (
+  VOID
+  )
+{
+  ScreenBufferUninstall ();
+
+  if (mScreenBuffer.Cells != NULL) {
+    FreePool (mScreenBuffer.Cells);
+    mScreenBuffer.Cells = NULL;
+  }
+  if (mScreenBuffer.LineBuffer != NULL) {
+    FreePool (mScreenBuffer.LineBuffer);
+    mScreenBuffer.LineBuffer = NULL;
+  }
+  mScreenBuffer.Columns = 0;
+  mScreenBuffer.Rows    = 0;
+}
+
+/**
+  Reset the text output device hardware and optionally run diagnostics.
+
+  @param  This                   The protocol instance pointer.
+  @param  ExtendedVerification   Driver may perform more exhaustive verification
+                                 operation of the device during reset.
+
+  @retval EFI_SUCCESS            The text output device was reset.
+  @retval EFI_DEVICE_ERROR       The text output device is not functioning correctly and
+                                 could not be reset.
+
+**/
+EFI_STATUS
+EFIAPI
+ScreenBufferReset (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL    *This,
+  IN  BOOLEAN                            ExtendedVerification
+  )
+{
+  EFI_STATUS                          Status;
+
+  Status = mScreenBuffer.ConOut->Reset (mScreenBuffer.ConOut, ExtendedVerification);
+  if (EFI_ERROR (ScreenBufferUpdateMode ())) {
+    ScreenBufferUninstall ();
+  }
+
+  return Status;
+}
+
+/**
+  Write a Unicode string to the output device.
+
+  Only the characters which differ from the screen buffer are sent to the
+  console. Changed characters separated by a few unchanged ones are sent in
+  one string, as moving the cursor would cost more. Strings with control
+  characters, wide strings and strings which may scroll the screen are sent
+  as they are.
+
+  @param  This                   The protocol instance pointer.
+  @param  String                 The NULL-terminated Unicode string to be displayed.
+
+  @retval EFI_SUCCESS            The string was output to the device.
+  @retval EFI_DEVICE_ERROR       The device reported an error while attempting to output
+                                 the text.
+  @retval EFI_UNSUPPORTED        The output device's mode is not currently in a
+                                 defined text mode.
+  @retval EFI_WARN_UNKNOWN_GLYPH This warning code indicates that some of the
+                                 characters in the Unicode string could not be
+                                 rendered and were skipped.
+
+**/
+EFI_STATUS
+EFIAPI
+ScreenBufferOutputString (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL    *This,
+  IN  CHAR16                             *String
+  )
+{
+  EFI_STATUS                          Status;
+  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL     *ConOut;
+  EFI_SIMPLE_TEXT_OUTPUT_MODE         *Mode;
+  SCREEN_BUFFER_CELL                  *Cells;
+  UINTN                               Length;
+  UINTN                               Width;
+  UINTN                               Index;
+  UINTN                               Start;
+  UINTN                               End;
+  UINT8                               Attribute;
+  BOOLEAN                             Printable;
+
+  ConOut = mScreenBuffer.ConOut;
+  Mode   = &mScreenBuffer.TextOutMode;
+
+  Printable = TRUE;
+  for (Length = 0; String[Length] != CHAR_NULL; Length++) {
+    if (String[Length] < CHAR_SPACE) {
+      Printable = FALSE;
+    }
+  }
+  if (Length == 0) {
+    return EFI_SUCCESS;
+  }
+
+  Width = Length;
+  if ((Mode->Attribute & EFI_WIDE_ATTRIBUTE) != 0) {
+    Width = Length * 2;
+  }
+
+  Cells = &mScreenBuffer.Cells[(UINTN) Mode->CursorRow * mScreenBuffer.Columns + (UINTN) Mode->CursorColumn];
+
+  if (!Printable || (Width != Length) ||
+      ((UINTN) Mode->CursorColumn + Length > mScreenBuffer.Columns) ||
+      (((UINTN) Mode->CursorRow == mScreenBuffer.Rows - 1) && ((UINTN) Mode->CursorColumn + Length == mScreenBuffer.Columns))) {
+    //
+    // The text written by the console cannot be found out. Send the string
+    // and forget what is known about the cells it may have changed.
+    //
+    ScreenBufferSyncConsole ();
+    Status = ConOut->OutputString (ConOut, String);
+
+    if (Printable && ((UINTN) Mode->CursorColumn + Width < mScreenBuffer.Columns)) {
+      ScreenBufferInvalidate ((UINTN) Mode->CursorRow * mScreenBuffer.Columns + (UINTN) Mode->CursorColumn, Width);
+    } else {
+      ScreenBufferInvalidate (0, mScreenBuffer.Columns * mScreenBuffer.Rows);
+    }
+
+    Mode->CursorColumn = ConOut->Mode->CursorColumn;
+    Mode->CursorRow    = ConOut->Mode->CursorRow;
+    return Status;
+  }
+
+  Status    = EFI_SUCCESS;
+  Attribute = (UINT8) Mode->Attribute;
+  Index     = 0;
+  while (Index < Length) {
+    if ((Cells[Index].Char == String[Index]) && (Cells[Index].Attribute == Attribute)) {
+      Index++;
+      continue;
+    }
+
+    //
+    // Find the end of the changed text, going over short runs of unchanged cells.
+    //
+    Start = Index;
+    End   = Index + 1;
+    for (Index = End; Index < Length; Index++) {
+      if ((Cells[Index].Char != String[Index]) || (Cells[Index].Attribute != Attribute)) {
+        End = Index + 1;
+      } else if (Index - End >= SCREEN_BUFFER_MAX_UNCHANGED_RUN) {
+        break;
+      }
+    }
+
+    if (ConOut->Mode->Attribute != Mode->Attribute) {
+      ConOut->SetAttribute (ConOut, (UINTN) Mode->Attribute);
+    }
+    if ((ConOut->Mode->CursorColumn != Mode->CursorColumn + (INT32) Start) || (ConOut->Mode->CursorRow != Mode->CursorRow)) {
+      ConOut->SetCursorPosition (ConOut, (UINTN) Mode->CursorColumn + Start, (UINTN) Mode->CursorRow);
+    }
+
+    CopyMem (mScreenBuffer.LineBuffer, &String[Start], (End - Start) * sizeof (CHAR16));
+    mScreenBuffer.LineBuffer[End - Start] = CHAR_NULL;
+    Status = ConOut->OutputString (ConOut, mScreenBuffer.LineBuffer);
+    if (EFI_ERROR (Status)) {
+      ScreenBufferInvalidate ((UINTN) Mode->CursorRow * mScreenBuffer.Columns + (UINTN) Mode->CursorColumn + Start, End - Start);
+      break;
+    }
+
+    for (Index = Start; Index < End; Index++) {
+      Cells[Index].Char      = String[Index];
+      Cells[Index].Attribute = Attribute;
+    }
+  }
+
+  Mode->CursorColumn += (INT32) Length;
+  if ((UINTN) Mode->CursorColumn == mScreenBuffer.Columns) {
+    Mode->CursorColumn = 0;
+    Mode->CursorRow++;
+  }
+
+  if (Mode->CursorVisible) {
+    ScreenBufferSyncConsole ();
+  }
+
+  return Status;
+}
+
+/**
+  Verifies that all characters in a Unicode string can be output to the
+  target device.
+
+  @param  This                   The protocol instance pointer.
+  @param  String                 The NULL-terminated Unicode string to be examined for the output
+                                 device(s).
+
+  @retval EFI_SUCCESS            The device(s) are capable of rendering the output string.
+  @retval EFI_UNSUPPORTED        Some of the characters in the Unicode string cannot be
+                                 rendered by one or more of the output devices mapped
+                                 by the EFI handle.
+
+**/
+EFI_STATUS
+EFIAPI
+ScreenBufferTestString (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL    *This,
+  IN  CHAR16                             *String
+  )
+{
+  return mScreenBuffer.ConOut->TestString (mScreenBuffer.ConOut, String);
+}
+
+/**
+  Returns information for an available text mode that the output device(s)
+  supports.
+
+  @param  This                   The protocol instance pointer.
+  @param  ModeNumber             The mode number to return information on.
+  @param  Columns                Returns the columns of the text output device for the
+                                 requested ModeNumber.
+  @param  Rows                   Returns the rows of the text output device for the
+                                 requested ModeNumber.
+
+  @retval EFI_SUCCESS            The requested mode information was returned.
+  @retval EFI_DEVICE_ERROR       The device had an error and could not
+                                 complete the request.
+  @retval EFI_UNSUPPORTED        The mode number was not valid.
+
+**/
+EFI_STATUS
+EFIAPI
+ScreenBufferQueryMode (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL    *This,
+  IN  UINTN                              ModeNumber,
+  OUT UINTN                              *Columns,
+  OUT UINTN                              *Rows
+  )
+{
+  return mScreenBuffer.ConOut->QueryMode (mScreenBuffer.ConOut, ModeNumber, Columns, Rows);
+}
+
+/**
+  Sets the output device(s) to a specified mode.
+
+  @param  This                   The protocol instance pointer.
+  @param  ModeNumber             The mode number to set.
+
+  @retval EFI_SUCCESS            The requested text mode was set.
+  @retval EFI_DEVICE_ERROR       The device had an error and
+                                 could not complete the request.
+  @retval EFI_UNSUPPORTED        The mode number was not valid.
+
+**/
+EFI_STATUS
+EFIAPI
+ScreenBufferSetMode (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL    *This,
+  IN  UINTN                              ModeNumber
+  )
+{
+  EFI_STATUS                          Status;
+
+  Status = mScreenBuffer.ConOut->SetMode (mScreenBuffer.ConOut, ModeNumber);
+  if (EFI_ERROR (ScreenBufferUpdateMode ())) {
+    //
+    // The screen buffer cannot follow the new mode, stop using it.
+    //
+    ScreenBufferUninstall ();
+  }
+
+  return Status;
+}
+
+/**
+  Sets the background and foreground colors for the OutputString () and
+  ClearScreen () functions. The attribute is sent to the console when text
+  is written with it.
+
+  @param  This                   The protocol instance pointer.
+  @param  Attribute              The attribute to set. Bits 0..3 are the foreground color, and
+                                 bits 4..6 are the background color. All other bits are undefined
+                                 and must be zero. The valid Attributes are defined in this file.
+
+  @retval EFI_SUCCESS            The attribute was set.
+  @retval EFI_UNSUPPORTED        The attribute requested is not defined.
+
+**/
+EFI_STATUS
+EFIAPI
+ScreenBufferSetAttribute (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL    *This,
+  IN  UINTN                              Attribute
+  )
+{
+  if ((Attribute | 0xFF) != 0xFF) {
+    return EFI_UNSUPPORTED;
+  }
+
+  mScreenBuffer.TextOutMode.Attribute = (INT32) Attribute;
+  return EFI_SUCCESS;
+}
+
+/**
+  Clears the output device(s) display to the currently selected background
+  color.
+
+  @param  This                   The protocol instance pointer.
+
+  @retval EFI_SUCCESS            The operation completed successfully.
+  @retval EFI_DEVICE_ERROR       The device had an error and
+                                 could not complete the request.
+  @retval EFI_UNSUPPORTED        The output device is not in a valid text mode.
+
+**/
+EFI_STATUS
+EFIAPI
+ScreenBufferClearScreen (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL    *This
+  )
+{
+  EFI_STATUS                          Status;
+  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL     *ConOut;
+  UINTN                               Index;
+  UINT8                               Attribute;
+
+  ConOut = mScreenBuffer.ConOut;
+
+  ScreenBufferSyncConsole ();
+  Status = ConOut->ClearScreen (ConOut);
+  if (EFI_ERROR (Status)) {
+    ScreenBufferInvalidate (0, mScreenBuffer.Columns * mScreenBuffer.Rows);
+  } else {
+    Attribute = (UINT8) (mScreenBuffer.TextOutMode.Attribute & ~EFI_WIDE_ATTRIBUTE);
+    for (Index = 0; Index < mScreenBuffer.Columns * mScreenBuffer.Rows; Index++) {
+      mScreenBuffer.Cells[Index].Char      = CHAR_SPACE;
+      mScreenBuffer.Cells[Index].Attribute = Attribute;
+    }
+  }
+
+  mScreenBuffer.TextOutMode.CursorColumn = ConOut->Mode->CursorColumn;
+  mScreenBuffer.TextOutMode.CursorRow    = ConOut->Mode->CursorRow;
+  return Status;
+}
+
+/**
+  Sets the current coordinates of the cursor position. The cursor is moved
+  on the console when text is written there, or when it is visible.
+
+  @param  This                   The protocol instance pointer.
+  @param  Column                 The position to set the cursor to. Must be greater than or
+                                 equal to zero and less than the number of columns and rows
+                                 by QueryMode ().
+  @param  Row                    The position to set the cursor to. Must be greater than or
+                                 equal to zero and less than the number of columns and rows
+                                 by QueryMode ().
+
+  @retval EFI_SUCCESS            The operation completed successfully.
+  @retval EFI_DEVICE_ERROR       The device had an error and
+                                 could not complete the request.
+  @retval EFI_UNSUPPORTED        The output device is not in a valid text mode, or the
+                                 cursor position is invalid for the current mode.
+
+**/
+EFI_STATUS
+EFIAPI
+ScreenBufferSetCursorPosition (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL    *This,
+  IN  UINTN                              Column,
+  IN  UINTN                              Row
+  )
+{
+  if ((Column >= mScreenBuffer.Columns) || (Row >= mScreenBuffer.Rows)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  mScreenBuffer.TextOutMode.CursorColumn = (INT32) Column;
+  mScreenBuffer.TextOutMode.CursorRow    = (INT32) Row;
+
+  if (mScreenBuffer.TextOutMode.CursorVisible) {
+    ScreenBufferSyncConsole ();
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Makes the cursor visible or invisible.
+
+  @param  This                   The protocol instance pointer.
+  @param  Visible                If TRUE, the cursor is set to be visible. If FALSE, the cursor is
+                                 set to be invisible.
+
+  @retval EFI_SUCCESS            The operation completed successfully.
+  @retval EFI_DEVICE_ERROR       The device had an error and could not complete the
+                                 request, or the device does not support changing
+                                 the cursor mode.
+  @retval EFI_UNSUPPORTED        The output device is not in a valid text mode.
+
+**/
+EFI_STATUS
+EFIAPI
+ScreenBufferEnableCursor (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL    *This,
+  IN  BOOLEAN                            Visible
+  )
+{
+  EFI_STATUS                          Status;
+
+  if (Visible) {
+    ScreenBufferSyncConsole ();
+  }
+
+  Status = mScreenBuffer.ConOut->EnableCursor (mScreenBuffer.ConOut, Visible);
+  mScreenBuffer.TextOutMode.CursorVisible = mScreenBuffer.ConOut->Mode->CursorVisible;
+
+  return Status;
+}
@@ -367,6 +367,36 @@ OutputConfigBody (
   return EFI_SUCCESS;
 }
 
+/**
+  Get the size of the buffer holding a multi-string format string.
+
+  The buffer starts with MAX_STRING_LENGTH bytes and is doubled each time the
+  string outgrows it, so the buffer size can be computed from the string size
+  and appending many strings does not reallocate the buffer for each of them.
+
+  This is a internal function.
+
+  @param  StringSize             Size of the string in bytes, including the
+                                 Null-terminator.
+
+  @return Size of the buffer in bytes.
+
+**/
+UINTN
+GetMultiStringBufferSize (
+  IN UINTN                         StringSize
+  )
+{
+  UINTN BufferSize;
+
+  BufferSize = MAX_STRING_LENGTH;
+  while (BufferSize < StringSize) {
+    BufferSize *= 2;
+  }
+
+  return BufferSize;
+}
+
 /**
   Append a string to a multi-string format.
 
@@ -375,11 +405,14 @@ OutputConfigBody (
   @param  MultiString            String in <MultiConfigRequest>,
                                  <MultiConfigAltResp>, or <MultiConfigResp>. On
                                  input, the buffer length of  this string is
-                                 MAX_STRING_LENGTH. On output, the  buffer length
-                                 might be updated.
+                                 MAX_STRING_LENGTH, or the length returned by
+                                 GetMultiStringBufferSize() if the string was
+                                 built by this function. On output, the buffer
+                                 length might be updated.
   @param  AppendString           NULL-terminated Unicode string.
 
   @retval EFI_INVALID_PARAMETER  Any incoming parameter is invalid.
+  @retval EFI_OUT_OF_RESOURCES   The buffer of MultiString can not be enlarged.
   @retval EFI_SUCCESS            AppendString is append to the end of MultiString
 
 **/
@@ -389,9 +422,10 @@ AppendToMultiString (
   IN EFI_STRING                    AppendString
   )
 {
-  UINTN AppendStringSize;
-  UINTN MultiStringSize;
-  UINTN MaxLen;
+  UINTN      AppendStringSize;
+  UINTN      MultiStringSize;
+  UINTN      BufferSize;
+  EFI_STRING NewMultiString;
 
   if (MultiString == NULL || *MultiString == NULL || AppendString == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -399,25 +433,27 @@ AppendToMultiString (
 
   AppendStringSize = StrSize (AppendString);
   MultiStringSize  = StrSize (*MultiString);
-  MaxLen = MAX_STRING_LENGTH / sizeof (CHAR16);
+  BufferSize       = GetMultiStringBufferSize (MultiStringSize);
 
   //
-  // Enlarge the buffer each time when length exceeds MAX_STRING_LENGTH.
+  // Enlarge the buffer when the appended string does not fit in it.
   //
-  if (MultiStringSize + AppendStringSize > MAX_STRING_LENGTH ||
-      MultiStringSize > MAX_STRING_LENGTH) {
-    *MultiString = (EFI_STRING) ReallocatePool (
-                                  MultiStringSize,
-                                  MultiStringSize + AppendStringSize,
-                                  (VOID *) (*MultiString)
-                                  );
-    MaxLen = (MultiStringSize + AppendStringSize) / sizeof (CHAR16);
-    ASSERT (*MultiString != NULL);
+  if (MultiStringSize + AppendStringSize - sizeof (CHAR16) > BufferSize) {
+    BufferSize     = GetMultiStringBufferSize (MultiStringSize + AppendStringSize - sizeof (CHAR16));
+    NewMultiString = (EFI_STRING) ReallocatePool (
+                                    MultiStringSize,
+                                    BufferSize,
+                                    (VOID *) (*MultiString)
+                                    );
+    if (NewMultiString == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+    *MultiString = NewMultiString;
   }
   //
   // Append the incoming string
   //
-  StrCatS (*MultiString, MaxLen, AppendString);
+  StrCatS (*MultiString, BufferSize / sizeof (CHAR16), AppendString);
 
   return EFI_SUCCESS;
 }
@@ -3123,6 +3159,272 @@ GenerateAltConfigResp (
   return EFI_SUCCESS;
 }
 
+/**
+  Compare two strings which may be NULL.
+
+  This is a internal function.
+
+  @param  FirstString            First string, may be NULL.
+  @param  SecondString           Second string, may be NULL.
+
+  @retval TRUE                   Both strings are NULL or have the same content.
+  @retval FALSE                  The strings are different.
+
+**/
+BOOLEAN
+IsSameConfigString (
+  IN EFI_STRING                    FirstString,
+  IN EFI_STRING                    SecondString
+  )
+{
+  if (FirstString == NULL || SecondString == NULL) {
+    return (BOOLEAN) (FirstString == SecondString);
+  }
+
+  return (BOOLEAN) (StrCmp (FirstString, SecondString) == 0);
+}
+
+/**
+  Remove an entry from the config cache and free it.
+
+  This is a internal function.
+
+  @param  CacheEntry             The config cache entry.
+
+**/
+VOID
+FreeConfigCacheEntry (
+  IN HII_CONFIG_CACHE_ENTRY        *CacheEntry
+  )
+{
+  RemoveEntryList (&CacheEntry->Entry);
+
+  if (CacheEntry->PlatformLanguage != NULL) {
+    FreePool (CacheEntry->PlatformLanguage);
+  }
+  if (CacheEntry->DevicePath != NULL) {
+    FreePool (CacheEntry->DevicePath);
+  }
+  if (CacheEntry->Request != NULL) {
+    FreePool (CacheEntry->Request);
+  }
+  if (CacheEntry->FullRequest != NULL) {
+    FreePool (CacheEntry->FullRequest);
+  }
+  if (CacheEntry->DefaultAltCfgResp != NULL) {
+    FreePool (CacheEntry->DefaultAltCfgResp);
+  }
+  FreePool (CacheEntry);
+}
+
+/**
+  Free all cached results of parsing the form packages of a package list.
+
+  @param  PackageList            The package list instance.
+
+**/
+VOID
+FlushConfigCache (
+  IN HII_DATABASE_PACKAGE_LIST_INSTANCE *PackageList
+  )
+{
+  while (!IsListEmpty (&PackageList->ConfigCacheHdr)) {
+    FreeConfigCacheEntry (
+      CR (PackageList->ConfigCacheHdr.ForwardLink, HII_CONFIG_CACHE_ENTRY, Entry, HII_CONFIG_CACHE_SIGNATURE)
+      );
+  }
+}
+
+/**
+  Find the cached result of parsing the form packages of a package list for
+  a <ConfigRequest>. The entries built from an older revision of the package
+  list are freed.
+
+  This is a internal function.
+
+  @param  PackageList            The package list instance.
+  @param  DevicePath             Device path of the package list.
+  @param  PlatformLanguage       Current platform language, may be NULL.
+  @param  Request                <ConfigRequest> passed in, may be NULL.
+
+  @return The config cache entry, or NULL if the result is not cached.
+
+**/
+HII_CONFIG_CACHE_ENTRY *
+FindConfigCacheEntry (
+  IN HII_DATABASE_PACKAGE_LIST_INSTANCE *PackageList,
+  IN EFI_DEVICE_PATH_PROTOCOL           *DevicePath,
+  IN CHAR8                              *PlatformLanguage,
+  IN EFI_STRING                         Request
+  )
+{
+  LIST_ENTRY                            *Link;
+  HII_CONFIG_CACHE_ENTRY                *CacheEntry;
+  UINTN                                 DevicePathSize;
+
+  DevicePathSize = GetDevicePathSize (DevicePath);
+
+  Link = PackageList->ConfigCacheHdr.ForwardLink;
+  while (Link != &PackageList->ConfigCacheHdr) {
+    CacheEntry = CR (Link, HII_CONFIG_CACHE_ENTRY, Entry, HII_CONFIG_CACHE_SIGNATURE);
+    Link       = Link->ForwardLink;
+
+    if (CacheEntry->Revision != PackageList->Revision) {
+      FreeConfigCacheEntry (CacheEntry);
+      continue;
+    }
+
+    if (PlatformLanguage == NULL || CacheEntry->PlatformLanguage == NULL) {
+      if (PlatformLanguage != CacheEntry->PlatformLanguage) {
+        continue;
+      }
+    } else if (AsciiStrCmp (PlatformLanguage, CacheEntry->PlatformLanguage) != 0) {
+      continue;
+    }
+
+    if ((GetDevicePathSize (CacheEntry->DevicePath) == DevicePathSize) &&
+        (CompareMem (CacheEntry->DevicePath, DevicePath, DevicePathSize) == 0) &&
+        IsSameConfigString (CacheEntry->Request, Request)) {
+      //
+      // Keep the most recently used entry at the head of the list.
+      //
+      RemoveEntryList (&CacheEntry->Entry);
+      InsertHeadList (&PackageList->ConfigCacheHdr, &CacheEntry->Entry);
+      return CacheEntry;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Cache the result of parsing the form packages of a package list for a
+  <ConfigRequest>. The least recently used entry is freed when the cache is
+  full. Failing to cache the result is not an error.
+
+  This is a internal function.
+
+  @param  PackageList            The package list instance.
+  @param  DevicePath             Device path of the package list.
+  @param  PlatformLanguage       Current platform language, may be NULL.
+  @param  Request                <ConfigRequest> passed in, may be NULL.
+  @param  FullRequest            <ConfigRequest> returned, may be NULL.
+  @param  DefaultAltCfgResp      Default values in <MultiConfigAltResp>, may be NULL.
+
+**/
+VOID
+AddConfigCacheEntry (
+  IN HII_DATABASE_PACKAGE_LIST_INSTANCE *PackageList,
+  IN EFI_DEVICE_PATH_PROTOCOL           *DevicePath,
+  IN CHAR8                              *PlatformLanguage,
+  IN EFI_STRING                         Request,
+  IN EFI_STRING                         FullRequest,
+  IN EFI_STRING                         DefaultAltCfgResp
+  )
+{
+  HII_CONFIG_CACHE_ENTRY                *CacheEntry;
+  LIST_ENTRY                            *Link;
+  UINTN                                 Count;
+
+  CacheEntry = AllocateZeroPool (sizeof (HII_CONFIG_CACHE_ENTRY));
+  if (CacheEntry == NULL) {
+    return;
+  }
+  CacheEntry->Signature = HII_CONFIG_CACHE_SIGNATURE;
+  CacheEntry->Revision  = PackageList->Revision;
+  InsertHeadList (&PackageList->ConfigCacheHdr, &CacheEntry->Entry);
+
+  CacheEntry->DevicePath = DuplicateDevicePath (DevicePath);
+  if (PlatformLanguage != NULL) {
+    CacheEntry->PlatformLanguage = AllocateCopyPool (AsciiStrSize (PlatformLanguage), PlatformLanguage);
+  }
+  if (Request != NULL) {
+    CacheEntry->Request = AllocateCopyPool (StrSize (Request), Request);
+  }
+  if (FullRequest != NULL) {
+    CacheEntry->FullRequest = AllocateCopyPool (StrSize (FullRequest), FullRequest);
+  }
+  if (DefaultAltCfgResp != NULL) {
+    CacheEntry->DefaultAltCfgResp = AllocateCopyPool (StrSize (DefaultAltCfgResp), DefaultAltCfgResp);
+  }
+
+  if ((CacheEntry->DevicePath == NULL) ||
+      ((PlatformLanguage != NULL) && (CacheEntry->PlatformLanguage == NULL)) ||
+      ((Request != NULL) && (CacheEntry->Request == NULL)) ||
+      ((FullRequest != NULL) && (CacheEntry->FullRequest == NULL)) ||
+      ((DefaultAltCfgResp != NULL) && (CacheEntry->DefaultAltCfgResp == NULL))) {
+    FreeConfigCacheEntry (CacheEntry);
+    return;
+  }
+
+  //
+  // Free the least recently used entry at the tail of the list.
+  //
+  Count = 0;
+  for (Link = PackageList->ConfigCacheHdr.ForwardLink; Link != &PackageList->ConfigCacheHdr; Link = Link->ForwardLink) {
+    Count++;
+  }
+  if (Count > HII_CONFIG_CACHE_MAX_ENTRIES) {
+    FreeConfigCacheEntry (
+      CR (PackageList->ConfigCacheHdr.BackLink, HII_CONFIG_CACHE_ENTRY, Entry, HII_CONFIG_CACHE_SIGNATURE)
+      );
+  }
+}
+
+/**
+  Return the cached result of parsing the form packages the same way as
+  GetFullStringFromHiiFormPackages() returns it.
+
+  This is a internal function.
+
+  @param  CacheEntry             The config cache entry.
+  @param  Request                Pointer to a null-terminated Unicode string in
+                                 <ConfigRequest> format, replaced by the full
+                                 request string if it has no request element.
+  @param  AltCfgResp             Pointer to a null-terminated Unicode string in
+                                 <ConfigAltResp> format, the default values are
+                                 merged into it.
+
+  @retval EFI_SUCCESS            The cached result is returned.
+  @retval EFI_OUT_OF_RESOURCES   Not enough memory for the return strings.
+
+**/
+EFI_STATUS
+GetFullStringFromConfigCache (
+  IN     HII_CONFIG_CACHE_ENTRY     *CacheEntry,
+  IN OUT EFI_STRING                 *Request,
+  IN OUT EFI_STRING                 *AltCfgResp
+  )
+{
+  EFI_STRING                   FullRequest;
+
+  if (!IsSameConfigString (*Request, CacheEntry->FullRequest)) {
+    FullRequest = AllocateCopyPool (StrSize (CacheEntry->FullRequest), CacheEntry->FullRequest);
+    if (FullRequest == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+    if (*Request != NULL) {
+      FreePool (*Request);
+    }
+    *Request = FullRequest;
+  }
+
+  if (CacheEntry->DefaultAltCfgResp == NULL) {
+    return EFI_SUCCESS;
+  }
+
+  if (*AltCfgResp != NULL) {
+    return MergeDefaultString (AltCfgResp, CacheEntry->DefaultAltCfgResp);
+  }
+
+  *AltCfgResp = AllocateCopyPool (StrSize (CacheEntry->DefaultAltCfgResp), CacheEntry->DefaultAltCfgResp);
+  if (*AltCfgResp == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   This function gets the full request string and full default value string by 
   parsing IFR data in HII form packages. 
@@ -3189,6 +3491,10 @@ GetFullStringFromHiiFormPackages (
   EFI_STRING                   ConfigHdr;
   EFI_STRING                   StringPtr;
   EFI_STRING                   Progress;
+  HII_CONFIG_CACHE_ENTRY       *CacheEntry;
+  CHAR8                        *PlatformLanguage;
+  EFI_STRING                   OriginalRequest;
+  BOOLEAN                      CacheResult;
 
   if (DataBaseRecord == NULL || DevicePath == NULL || Request == NULL || AltCfgResp == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -3205,6 +3511,28 @@ GetFullStringFromHiiFormPackages (
   HiiFormPackage    = NULL;
   PackageSize       = 0;
   Progress          = *Request;
+  PlatformLanguage  = NULL;
+  OriginalRequest   = NULL;
+  CacheResult       = FALSE;
+
+  //
+  // The result only depends on the package list, the request and the platform
+  // language used to get the IFR strings. Return it from the config cache of
+  // the package list if the same request has been parsed before.
+  //
+  GetEfiGlobalVariable2 (L"PlatformLang", (VOID**)&PlatformLanguage, NULL);
+  CacheEntry = FindConfigCacheEntry (DataBaseRecord->PackageList, DevicePath, PlatformLanguage, *Request);
+  if (CacheEntry != NULL) {
+    Status = GetFullStringFromConfigCache (CacheEntry, Request, AltCfgResp);
+    goto Done;
+  }
+
+  if (*Request == NULL) {
+    CacheResult = TRUE;
+  } else {
+    OriginalRequest = AllocateCopyPool (StrSize (*Request), *Request);
+    CacheResult     = (BOOLEAN) (OriginalRequest != NULL);
+  }
 
   Status = GetFormPackageData (DataBaseRecord, &HiiFormPackage, &PackageSize);
   if (EFI_ERROR (Status)) {
@@ -3345,12 +3673,37 @@ GetFullStringFromHiiFormPackages (
   //
   if (*AltCfgResp != NULL && DefaultAltCfgResp != NULL) {
     Status = MergeDefaultString (AltCfgResp, DefaultAltCfgResp);
-    FreePool (DefaultAltCfgResp);
-  } else if (*AltCfgResp == NULL) {
-    *AltCfgResp = DefaultAltCfgResp;
+  } else if (*AltCfgResp == NULL && DefaultAltCfgResp != NULL) {
+    *AltCfgResp = AllocateCopyPool (StrSize (DefaultAltCfgResp), DefaultAltCfgResp);
+    if (*AltCfgResp == NULL) {
+      Status = EFI_OUT_OF_RESOURCES;
+    }
   }
 
 Done:
+  if (CacheResult && !EFI_ERROR (Status)) {
+    AddConfigCacheEntry (
+      DataBaseRecord->PackageList,
+      DevicePath,
+      PlatformLanguage,
+      OriginalRequest,
+      *Request,
+      DefaultAltCfgResp
+      );
+  }
+
+  if (DefaultAltCfgResp != NULL) {
+    FreePool (DefaultAltCfgResp);
+  }
+
+  if (OriginalRequest != NULL) {
+    FreePool (OriginalRequest);
+  }
+
+  if (PlatformLanguage != NULL) {
+    FreePool (PlatformLanguage);
+  }
+
   if (RequestBlockArray != NULL) {
     //
     // Free Link Array RequestBlockArray
@@ -4613,9 +4966,12 @@ HiiBlockToConfig (
     StringPtr++;
   }
   if (*StringPtr == 0) {
+    Status = AppendToMultiString(Config, ConfigRequest);
+    if (EFI_ERROR (Status)) {
+      *Progress = ConfigRequest;
+      goto Exit;
+    }
     *Progress = StringPtr;
-
-    AppendToMultiString(Config, ConfigRequest);
     HiiToLower (*Config);
 
     return EFI_SUCCESS;
@@ -4630,8 +4986,12 @@ HiiBlockToConfig (
   //
   TemChar = *StringPtr;
   *StringPtr = '\0';
-  AppendToMultiString(Config, ConfigRequest);
+  Status = AppendToMultiString(Config, ConfigRequest);
   *StringPtr = TemChar;
+  if (EFI_ERROR (Status)) {
+    *Progress = ConfigRequest;
+    goto Exit;
+  }
 
   //
   // Parse each <RequestElement> if exists
@@ -4744,7 +5104,11 @@ HiiBlockToConfig (
     StrCatS (ConfigElement, Length, L"VALUE=");
     StrCatS (ConfigElement, Length, ValueStr);
 
-    AppendToMultiString (Config, ConfigElement);
+    Status = AppendToMultiString (Config, ConfigElement);
+    if (EFI_ERROR (Status)) {
+      *Progress = ConfigRequest;
+      goto Exit;
+    }
 
     FreePool (ConfigElement);
     FreePool (ValueStr);
@@ -4757,7 +5121,11 @@ HiiBlockToConfig (
     if (*StringPtr == 0) {
       break;
     }
-    AppendToMultiString (Config, L"&");
+    Status = AppendToMultiString (Config, L"&");
+    if (EFI_ERROR (Status)) {
+      *Progress = ConfigRequest;
+      goto Exit;
+    }
     StringPtr++;
 
   }
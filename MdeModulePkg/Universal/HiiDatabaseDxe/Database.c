@@ -63,8 +63,10 @@ GenerateHiiDatabaseRecord (
   InitializeListHead (&PackageList->StringPkgHdr);
   InitializeListHead (&PackageList->FontPkgHdr);
   InitializeListHead (&PackageList->SimpleFontPkgHdr);
+  InitializeListHead (&PackageList->ConfigCacheHdr);
   PackageList->ImagePkg      = NULL;
   PackageList->DevicePathPkg = NULL;
+  PackageList->Revision      = 0;
 
   //
   // Create a new hii handle
@@ -951,6 +953,7 @@ AdjustStringPackage (
       *BlockPtr = EFI_HII_SIBT_END;
       FreePool (StringPackage->StringBlock);
       StringPackage->StringBlock = StringBlock;
+      InvalidateStringIndex (StringPackage);
       StringPackage->StringPkgHdr->Header.Length += Skip2BlockSize;
       PackageList->PackageListHdr.PackageLength += Skip2BlockSize;
       StringPackage->MaxStringId = MaxStringId;
@@ -1090,6 +1093,7 @@ RemoveStringPackages (
 
     RemoveEntryList (&Package->StringEntry);
     PackageList->PackageListHdr.PackageLength -= Package->StringPkgHdr->Header.Length;
+    InvalidateStringIndex (Package);
     FreePool (Package->StringBlock);
     FreePool (Package->StringPkgHdr);
     //
@@ -2426,6 +2430,11 @@ AddPackages (
   SimpleFontPackage     = NULL;
   KeyboardLayoutPackage = NULL;
 
+  //
+  // The cached results of parsing the form packages are out of date.
+  //
+  DatabaseRecord->PackageList->Revision++;
+
   //
   // Process the package list header
   //
@@ -2969,6 +2978,7 @@ HiiRemovePackageList (
 
       HiiHandle->Signature = 0;
       FreePool (HiiHandle);
+      FlushConfigCache (Node->PackageList);
       FreePool (Node->PackageList);
       FreePool (Node);
 
@@ -3035,6 +3045,7 @@ HiiUpdatePackageList (
     Node = CR (Link, HII_DATABASE_RECORD, DatabaseEntry, HII_DATABASE_RECORD_SIGNATURE);
     if (Node->Handle == Handle) {
       OldPackageList = Node->PackageList;
+      OldPackageList->Revision++;
       //
       // Remove the package if its type matches one of the package types which is
       // contained in the new package list.
@@ -141,6 +141,16 @@ typedef struct {
 // String Package definitions
 //
 #define HII_STRING_PACKAGE_SIGNATURE    SIGNATURE_32 ('h','i','s','p')
+
+//
+// Location of a string in the string blocks, indexed by StringId.
+// TextOffset is 0 for the ids that are not indexed, such as skipped ids.
+//
+typedef struct {
+  UINT32                                BlockOffset;   // offset of the string block in StringBlock
+  UINT32                                TextOffset;    // offset of the string text in the string block
+} HII_STRING_INDEX_ENTRY;
+
 typedef struct _HII_STRING_PACKAGE_INSTANCE {
   UINTN                                 Signature;
   EFI_HII_STRING_PACKAGE_HDR            *StringPkgHdr;
@@ -149,6 +159,7 @@ typedef struct _HII_STRING_PACKAGE_INSTANCE {
   LIST_ENTRY                            FontInfoList;  // local font info list
   UINT8                                 FontId;
   EFI_STRING_ID                         MaxStringId;   // record StringId
+  HII_STRING_INDEX_ENTRY                *StringIndex;  // built on the first lookup, freed when StringBlock changes
 } HII_STRING_PACKAGE_INSTANCE;
 
 //
@@ -259,8 +270,28 @@ typedef struct _HII_DATABASE_PACKAGE_LIST_INSTANCE {
   HII_IMAGE_PACKAGE_INSTANCE            *ImagePkg;
   LIST_ENTRY                            SimpleFontPkgHdr;
   UINT8                                 *DevicePathPkg;
+  UINTN                                 Revision;       // changed whenever the packages or strings change
+  LIST_ENTRY                            ConfigCacheHdr; // cached results of parsing the form packages
 } HII_DATABASE_PACKAGE_LIST_INSTANCE;
 
+//
+// Result of parsing the form packages of a package list for one <ConfigRequest>.
+// The entry is only valid for the package list revision it was built from.
+//
+#define HII_CONFIG_CACHE_SIGNATURE      SIGNATURE_32 ('h','i','c','c')
+#define HII_CONFIG_CACHE_MAX_ENTRIES    32
+
+typedef struct {
+  UINTN                                 Signature;
+  LIST_ENTRY                            Entry;
+  UINTN                                 Revision;
+  CHAR8                                 *PlatformLanguage;  // language of the strings in the result, may be NULL
+  EFI_DEVICE_PATH_PROTOCOL              *DevicePath;
+  EFI_STRING                            Request;            // <ConfigRequest> on input, may be NULL
+  EFI_STRING                            FullRequest;        // <ConfigRequest> on output, may be NULL
+  EFI_STRING                            DefaultAltCfgResp;  // default values in <MultiConfigAltResp>, may be NULL
+} HII_CONFIG_CACHE_ENTRY;
+
 #define HII_HANDLE_SIGNATURE            SIGNATURE_32 ('h','i','h','l')
 
 typedef struct {
@@ -520,6 +551,18 @@ FindStringBlock (
   OUT EFI_STRING_ID                   *StartStringId OPTIONAL
   );
 
+/**
+  Free the StringId index of a string package. It must be called whenever the
+  string blocks of the package are reallocated or modified.
+
+  @param  StringPackage           Hii string package instance.
+
+**/
+VOID
+InvalidateStringIndex (
+  IN OUT HII_STRING_PACKAGE_INSTANCE  *StringPackage
+  );
+
 
 /**
   Parse all glyph blocks to find a glyph block specified by CharValue.
@@ -579,6 +622,17 @@ ExportFormPackages (
   IN OUT UINTN                          *ResultSize
   );
 
+/**
+  Free all cached results of parsing the form packages of a package list.
+
+  @param  PackageList            The package list instance.
+
+**/
+VOID
+FlushConfigCache (
+  IN HII_DATABASE_PACKAGE_LIST_INSTANCE *PackageList
+  );
+
 //
 // EFI_HII_FONT_PROTOCOL protocol interfaces
 //
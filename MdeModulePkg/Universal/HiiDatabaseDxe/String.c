@@ -232,6 +232,215 @@ GetStringFontInfo (
 }
 
 
+/**
+  Free the StringId index of a string package. It must be called whenever the
+  string blocks of the package are reallocated or modified.
+
+  @param  StringPackage           Hii string package instance.
+
+**/
+VOID
+InvalidateStringIndex (
+  IN OUT HII_STRING_PACKAGE_INSTANCE  *StringPackage
+  )
+{
+  if (StringPackage->StringIndex != NULL) {
+    FreePool (StringPackage->StringIndex);
+    StringPackage->StringIndex = NULL;
+  }
+}
+
+
+/**
+  Record the location of a string in the StringId index.
+
+  @param  StringPackage           Hii string package instance.
+  @param  StringId                The string's id.
+  @param  BlockHdr                The string block holding the string.
+  @param  StringTextPtr           The string text in the string block.
+
+**/
+VOID
+SetStringIndexEntry (
+  IN OUT HII_STRING_PACKAGE_INSTANCE  *StringPackage,
+  IN     EFI_STRING_ID                StringId,
+  IN     UINT8                        *BlockHdr,
+  IN     UINT8                        *StringTextPtr
+  )
+{
+  if (StringId <= StringPackage->MaxStringId) {
+    StringPackage->StringIndex[StringId].BlockOffset = (UINT32) (BlockHdr - StringPackage->StringBlock);
+    StringPackage->StringIndex[StringId].TextOffset  = (UINT32) (StringTextPtr - BlockHdr);
+  }
+}
+
+
+/**
+  Parse all string blocks once and build the index from StringId to the string
+  block and string text, so that FindStringBlock() does not parse the string
+  blocks from the start for every string.
+
+  Duplicate strings are indexed at the location of the string they refer to.
+  Skipped ids are not indexed; FindStringBlock() parses the string blocks for
+  them as before. If the string blocks cannot be parsed, no index is built.
+
+  @param  StringPackage           Hii string package instance.
+
+**/
+VOID
+BuildStringIndex (
+  IN OUT HII_STRING_PACKAGE_INSTANCE  *StringPackage
+  )
+{
+  UINT8                                *BlockHdr;
+  EFI_STRING_ID                        CurrentStringId;
+  EFI_STRING_ID                        DuplicateStringId;
+  UINTN                                BlockSize;
+  UINTN                                Index;
+  UINT8                                *StringTextPtr;
+  UINT16                               StringCount;
+  UINT16                               SkipCount;
+  UINT8                                Length8;
+  UINT32                               Length32;
+  EFI_HII_SIBT_EXT2_BLOCK              Ext2;
+  UINTN                                StringSize;
+
+  ASSERT (StringPackage->StringIndex == NULL);
+
+  StringPackage->StringIndex = AllocateZeroPool ((StringPackage->MaxStringId + 1) * sizeof (HII_STRING_INDEX_ENTRY));
+  if (StringPackage->StringIndex == NULL) {
+    return;
+  }
+
+  CurrentStringId = 1;
+  BlockHdr        = StringPackage->StringBlock;
+  BlockSize       = 0;
+  while (*BlockHdr != EFI_HII_SIBT_END) {
+    switch (*BlockHdr) {
+    case EFI_HII_SIBT_STRING_SCSU:
+      StringTextPtr = BlockHdr + sizeof (EFI_HII_STRING_BLOCK);
+      SetStringIndexEntry (StringPackage, CurrentStringId, BlockHdr, StringTextPtr);
+      BlockSize += (StringTextPtr - BlockHdr) + AsciiStrSize ((CHAR8 *) StringTextPtr);
+      CurrentStringId++;
+      break;
+
+    case EFI_HII_SIBT_STRING_SCSU_FONT:
+      StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRING_SCSU_FONT_BLOCK) - sizeof (UINT8);
+      SetStringIndexEntry (StringPackage, CurrentStringId, BlockHdr, StringTextPtr);
+      BlockSize += (StringTextPtr - BlockHdr) + AsciiStrSize ((CHAR8 *) StringTextPtr);
+      CurrentStringId++;
+      break;
+
+    case EFI_HII_SIBT_STRINGS_SCSU:
+    case EFI_HII_SIBT_STRINGS_SCSU_FONT:
+      if (*BlockHdr == EFI_HII_SIBT_STRINGS_SCSU) {
+        CopyMem (&StringCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK), sizeof (UINT16));
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRINGS_SCSU_BLOCK) - sizeof (UINT8);
+      } else {
+        CopyMem (&StringCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK) + sizeof (UINT8), sizeof (UINT16));
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRINGS_SCSU_FONT_BLOCK) - sizeof (UINT8);
+      }
+      BlockSize += StringTextPtr - BlockHdr;
+      for (Index = 0; Index < StringCount; Index++) {
+        SetStringIndexEntry (StringPackage, CurrentStringId, BlockHdr, StringTextPtr);
+        BlockSize     += AsciiStrSize ((CHAR8 *) StringTextPtr);
+        StringTextPtr += AsciiStrSize ((CHAR8 *) StringTextPtr);
+        CurrentStringId++;
+      }
+      break;
+
+    case EFI_HII_SIBT_STRING_UCS2:
+    case EFI_HII_SIBT_STRING_UCS2_FONT:
+      if (*BlockHdr == EFI_HII_SIBT_STRING_UCS2) {
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_STRING_BLOCK);
+      } else {
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRING_UCS2_FONT_BLOCK) - sizeof (CHAR16);
+      }
+      SetStringIndexEntry (StringPackage, CurrentStringId, BlockHdr, StringTextPtr);
+      GetUnicodeStringTextOrSize (NULL, StringTextPtr, &StringSize);
+      BlockSize += (StringTextPtr - BlockHdr) + StringSize;
+      CurrentStringId++;
+      break;
+
+    case EFI_HII_SIBT_STRINGS_UCS2:
+    case EFI_HII_SIBT_STRINGS_UCS2_FONT:
+      if (*BlockHdr == EFI_HII_SIBT_STRINGS_UCS2) {
+        CopyMem (&StringCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK), sizeof (UINT16));
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRINGS_UCS2_BLOCK) - sizeof (CHAR16);
+      } else {
+        CopyMem (&StringCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK) + sizeof (UINT8), sizeof (UINT16));
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRINGS_UCS2_FONT_BLOCK) - sizeof (CHAR16);
+      }
+      BlockSize += StringTextPtr - BlockHdr;
+      for (Index = 0; Index < StringCount; Index++) {
+        SetStringIndexEntry (StringPackage, CurrentStringId, BlockHdr, StringTextPtr);
+        GetUnicodeStringTextOrSize (NULL, StringTextPtr, &StringSize);
+        BlockSize     += StringSize;
+        StringTextPtr += StringSize;
+        CurrentStringId++;
+      }
+      break;
+
+    case EFI_HII_SIBT_DUPLICATE:
+      CopyMem (&DuplicateStringId, BlockHdr + sizeof (EFI_HII_STRING_BLOCK), sizeof (EFI_STRING_ID));
+      if ((DuplicateStringId < CurrentStringId) && (CurrentStringId <= StringPackage->MaxStringId)) {
+        CopyMem (
+          &StringPackage->StringIndex[CurrentStringId],
+          &StringPackage->StringIndex[DuplicateStringId],
+          sizeof (HII_STRING_INDEX_ENTRY)
+          );
+      }
+      BlockSize += sizeof (EFI_HII_SIBT_DUPLICATE_BLOCK);
+      CurrentStringId++;
+      break;
+
+    case EFI_HII_SIBT_SKIP1:
+      SkipCount = (UINT16) (*(UINT8*)((UINTN)BlockHdr + sizeof (EFI_HII_STRING_BLOCK)));
+      CurrentStringId = (UINT16) (CurrentStringId + SkipCount);
+      BlockSize += sizeof (EFI_HII_SIBT_SKIP1_BLOCK);
+      break;
+
+    case EFI_HII_SIBT_SKIP2:
+      CopyMem (&SkipCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK), sizeof (UINT16));
+      CurrentStringId = (UINT16) (CurrentStringId + SkipCount);
+      BlockSize += sizeof (EFI_HII_SIBT_SKIP2_BLOCK);
+      break;
+
+    case EFI_HII_SIBT_EXT1:
+      CopyMem (&Length8, BlockHdr + sizeof (EFI_HII_STRING_BLOCK) + sizeof (UINT8), sizeof (UINT8));
+      BlockSize += Length8;
+      break;
+
+    case EFI_HII_SIBT_EXT2:
+      CopyMem (&Ext2, BlockHdr, sizeof (EFI_HII_SIBT_EXT2_BLOCK));
+      BlockSize += Ext2.Length;
+      break;
+
+    case EFI_HII_SIBT_EXT4:
+      CopyMem (&Length32, BlockHdr + sizeof (EFI_HII_STRING_BLOCK) + sizeof (UINT8), sizeof (UINT32));
+      BlockSize += Length32;
+      break;
+
+    default:
+      //
+      // Unknown block, its size cannot be found out.
+      //
+      InvalidateStringIndex (StringPackage);
+      return;
+    }
+
+    if (StringPackage->StringBlock + BlockSize == BlockHdr) {
+      //
+      // Zero-length extended block, the string blocks are malformed.
+      //
+      InvalidateStringIndex (StringPackage);
+      return;
+    }
+    BlockHdr = StringPackage->StringBlock + BlockSize;
+  }
+}
+
+
 /**
   Parse all string blocks to find a String block specified by StringId.
   If StringId = (EFI_STRING_ID) (-1), find out all EFI_HII_SIBT_FONT blocks
@@ -301,6 +510,23 @@ FindStringBlock (
     if (StringId > StringPackage->MaxStringId) {
       return EFI_NOT_FOUND;
     }
+
+    //
+    // Look up the string in the StringId index, building the index on the
+    // first lookup. Ids that are not in the index are searched by parsing
+    // the string blocks as before.
+    //
+    if (StartStringId == NULL) {
+      if (StringPackage->StringIndex == NULL) {
+        BuildStringIndex (StringPackage);
+      }
+      if ((StringPackage->StringIndex != NULL) && (StringPackage->StringIndex[StringId].TextOffset != 0)) {
+        *StringBlockAddr  = StringPackage->StringBlock + StringPackage->StringIndex[StringId].BlockOffset;
+        *BlockType        = **StringBlockAddr;
+        *StringTextOffset = StringPackage->StringIndex[StringId].TextOffset;
+        return EFI_SUCCESS;
+      }
+    }
   } else {
     ASSERT (Private != NULL && Private->Signature == HII_DATABASE_PRIVATE_DATA_SIGNATURE);
     if (StringId == 0 && LastStringId != NULL) {
@@ -845,6 +1071,7 @@ InsertLackStringBlock (
   }
   FreePool (StringPackage->StringBlock);
   StringPackage->StringBlock = StringBlock;
+  InvalidateStringIndex (StringPackage);
   StringPackage->StringPkgHdr->Header.Length += NewBlockSize - OldBlockSize;
 
   return EFI_SUCCESS;
@@ -1012,6 +1239,7 @@ SetStringWorker (
 
     FreePool (StringPackage->StringBlock);
     StringPackage->StringBlock = Block;
+    InvalidateStringIndex (StringPackage);
     StringPackage->StringPkgHdr->Header.Length += (UINT32) (BlockSize - OldBlockSize);
     break;
 
@@ -1045,6 +1273,7 @@ SetStringWorker (
 
     FreePool (StringPackage->StringBlock);
     StringPackage->StringBlock = Block;
+    InvalidateStringIndex (StringPackage);
     StringPackage->StringPkgHdr->Header.Length += (UINT32) (BlockSize - OldBlockSize);
     break;
 
@@ -1096,6 +1325,7 @@ SetStringWorker (
 
   FreePool (StringPackage->StringBlock);
   StringPackage->StringBlock = Block;
+  InvalidateStringIndex (StringPackage);
   StringPackage->StringPkgHdr->Header.Length += Ext2.Length;
 
   return EFI_SUCCESS;
@@ -1279,6 +1509,7 @@ HiiNewString (
       *BlockPtr = EFI_HII_SIBT_END;
       FreePool (StringPackage->StringBlock);
       StringPackage->StringBlock = StringBlock;
+      InvalidateStringIndex (StringPackage);
       StringPackage->StringPkgHdr->Header.Length += Ucs2BlockSize;
       PackageListNode->PackageListHdr.PackageLength += Ucs2BlockSize;
     }
@@ -1410,6 +1641,7 @@ HiiNewString (
     *BlockPtr = EFI_HII_SIBT_END;
     FreePool (StringPackage->StringBlock);
     StringPackage->StringBlock = StringBlock;
+    InvalidateStringIndex (StringPackage);
     StringPackage->StringPkgHdr->Header.Length += Ucs2BlockSize;
     PackageListNode->PackageListHdr.PackageLength += Ucs2BlockSize;
 
@@ -1452,6 +1684,7 @@ HiiNewString (
       *BlockPtr = EFI_HII_SIBT_END;
       FreePool (StringPackage->StringBlock);
       StringPackage->StringBlock = StringBlock;
+      InvalidateStringIndex (StringPackage);
       StringPackage->StringPkgHdr->Header.Length += Ucs2FontBlockSize;
       PackageListNode->PackageListHdr.PackageLength += Ucs2FontBlockSize;
 
@@ -1513,6 +1746,7 @@ HiiNewString (
       *BlockPtr = EFI_HII_SIBT_END;
       FreePool (StringPackage->StringBlock);
       StringPackage->StringBlock = StringBlock;
+      InvalidateStringIndex (StringPackage);
       StringPackage->StringPkgHdr->Header.Length += FontBlockSize + Ucs2FontBlockSize;
       PackageListNode->PackageListHdr.PackageLength += FontBlockSize + Ucs2FontBlockSize;
 
@@ -1548,7 +1782,9 @@ Done:
       ) {
         StringPackage = CR (Link, HII_STRING_PACKAGE_INSTANCE, StringEntry, HII_STRING_PACKAGE_SIGNATURE);
         StringPackage->MaxStringId = *StringId;
+        InvalidateStringIndex (StringPackage);
     }
+    PackageListNode->Revision++;
   } else if (NewStringPackageCreated) {
     //
     // Free the allocated new string Package when new string can't be added.
@@ -1753,6 +1989,7 @@ HiiSetString (
           return Status;
         }
         PackageListNode->PackageListHdr.PackageLength += StringPackage->StringPkgHdr->Header.Length - OldPackageLen;
+        PackageListNode->Revision++;
         return EFI_SUCCESS;
       }
     }
@@ -39,6 +39,13 @@ EFI_DPC_PROTOCOL mDpc = {
 UINTN  mDpcQueueDepth = 0;
 UINTN  mMaxDpcQueueDepth = 0;
 
+//
+// Global variables used to measure the DPC Queue Depths of each TPL, which
+// shows at which level queued DPCs pile up.
+//
+UINTN  mDpcTplQueueDepth[TPL_HIGH_LEVEL + 1];
+UINTN  mMaxDpcTplQueueDepth[TPL_HIGH_LEVEL + 1];
+
 //
 // Free list of DPC entries.  As DPCs are queued, entries are removed from this
 // free list.  As DPC entries are dispatched, DPC entries are added to the free list.
@@ -54,6 +61,47 @@ LIST_ENTRY      mDpcEntryFreeList = INITIALIZE_LIST_HEAD_VARIABLE(mDpcEntryFreeL
 //
 LIST_ENTRY      mDpcQueue[TPL_HIGH_LEVEL + 1];
 
+/**
+  Allocate a block of DPC entries and add them to the DPC free list.
+
+  The caller must be running at TPL_NOTIFY or below, as memory is allocated.
+
+  @retval EFI_SUCCESS            DPC_ENTRY_GROW_COUNT entries were added to the
+                                 free list.
+  @retval EFI_OUT_OF_RESOURCES   There are not enough resources available.
+
+**/
+EFI_STATUS
+DpcGrowFreeList (
+  VOID
+  )
+{
+  DPC_ENTRY   *DpcEntry;
+  EFI_TPL     OriginalTpl;
+  UINTN       Index;
+
+  //
+  // Allocate all the new DPC entries at once. They are never freed.
+  //
+  DpcEntry = AllocatePool (DPC_ENTRY_GROW_COUNT * sizeof (DPC_ENTRY));
+  if (DpcEntry == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Raise the TPL level to TPL_HIGH_LEVEL for DPC list operations
+  //
+  OriginalTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
+
+  for (Index = 0; Index < DPC_ENTRY_GROW_COUNT; Index++) {
+    InsertTailList (&mDpcEntryFreeList, &DpcEntry[Index].ListEntry);
+  }
+
+  gBS->RestoreTPL (OriginalTpl);
+
+  return EFI_SUCCESS;
+}
+
 /**
   Add a Deferred Procedure Call to the end of the DPC queue.
 
@@ -82,7 +130,6 @@ DpcQueueDpc (
   EFI_STATUS  ReturnStatus;
   EFI_TPL     OriginalTpl;
   DPC_ENTRY   *DpcEntry;
-  UINTN       Index;
 
   //
   // Make sure DpcTpl is valid
@@ -112,7 +159,7 @@ DpcQueueDpc (
   //
   // Check to see if there are any entries in the DPC free list
   //
-  if (IsListEmpty (&mDpcEntryFreeList)) {
+  while (IsListEmpty (&mDpcEntryFreeList)) {
     //
     // If the current TPL is greater than TPL_NOTIFY, then memory allocations
     // can not be performed, so the free list can not be expanded.  In this case
@@ -124,39 +171,16 @@ DpcQueueDpc (
     }
 
     //
-    // Add 64 DPC entries to the free list
+    // Lower the TPL level to perform the memory allocation. Another DPC
+    // may take the new entries before the TPL is raised again, so check
+    // the free list again afterwards.
     //
-    for (Index = 0; Index < 64; Index++) {
-      //
-      // Lower the TPL level to perform a memory allocation
-      //
-      gBS->RestoreTPL (OriginalTpl);
-
-      //
-      // Allocate a new DPC entry
-      //
-      DpcEntry = AllocatePool (sizeof (DPC_ENTRY));
-
-      //
-      // Raise the TPL level back to TPL_HIGH_LEVEL for DPC list operations
-      //
-      gBS->RaiseTPL (TPL_HIGH_LEVEL);
-
-      //
-      // If the allocation of a DPC entry fails, and the free list is empty,
-      // then return EFI_OUT_OF_RESOURCES.
-      //
-      if (DpcEntry == NULL) {
-        if (IsListEmpty (&mDpcEntryFreeList)) {
-          ReturnStatus = EFI_OUT_OF_RESOURCES;
-          goto Done;
-        }
-      }
+    gBS->RestoreTPL (OriginalTpl);
+    ReturnStatus = DpcGrowFreeList ();
+    gBS->RaiseTPL (TPL_HIGH_LEVEL);
 
-      //
-      // Add the newly allocated DPC entry to the DPC free list
-      //
-      InsertTailList (&mDpcEntryFreeList, &DpcEntry->ListEntry);
+    if (EFI_ERROR (ReturnStatus)) {
+      goto Done;
     }
   }
 
@@ -193,6 +217,14 @@ DpcQueueDpc (
     mMaxDpcQueueDepth = mDpcQueueDepth;
   }
 
+  //
+  // Measure the DPC queue depth of the specified DpcTpl
+  //
+  mDpcTplQueueDepth[DpcTpl]++;
+  if (mDpcTplQueueDepth[DpcTpl] > mMaxDpcTplQueueDepth[DpcTpl]) {
+    mMaxDpcTplQueueDepth[DpcTpl] = mDpcTplQueueDepth[DpcTpl];
+  }
+
 Done:
   //
   // Restore the original TPL level when this function was called
@@ -262,6 +294,7 @@ DpcDispatchDpc (
         // Decrement the measured DPC Queue Depth across all TPLs
         //
         mDpcQueueDepth--;
+        mDpcTplQueueDepth[Tpl]--;
 
         //
         // Lower the TPL to TPL value of the current DPC queue
@@ -332,6 +365,16 @@ DpcDriverEntryPoint (
     InitializeListHead (&mDpcQueue[Index]);
   }
 
+  //
+  // Populate the DPC free list up front, so DPCs can be queued above
+  // TPL_NOTIFY right away, and the first received packets don't pay for
+  // the allocation.
+  //
+  Status = DpcGrowFreeList ();
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
   //
   // Install the EFI_DPC_PROTOCOL instance onto a new handle
   //
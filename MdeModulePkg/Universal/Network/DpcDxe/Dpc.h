@@ -39,6 +39,11 @@ typedef struct {
   VOID               *DpcContext;
 } DPC_ENTRY;
 
+//
+// Number of DPC entries added to the free list each time it runs empty.
+//
+#define DPC_ENTRY_GROW_COUNT  64
+
 /**
   Add a Deferred Procedure Call to the end of the DPC queue.
 
@@ -280,11 +280,20 @@ Ip4Reassemble (
   //
   Head = &Assemble->Fragments;
 
-  NET_LIST_FOR_EACH (Cur, Head) {
-    Fragment = NET_LIST_USER_STRUCT (Cur, NET_BUF, List);
+  //
+  // Fragments of a large datagram normally arrive in order. Check the
+  // tail first, so appending such a fragment doesn't walk the whole list.
+  //
+  Cur = Head;
 
-    if (This->Start < IP4_GET_CLIP_INFO (Fragment)->Start) {
-      break;
+  if (!IsListEmpty (Head) &&
+      (This->Start < IP4_GET_CLIP_INFO (NET_LIST_TAIL (Head, NET_BUF, List))->Start)) {
+    NET_LIST_FOR_EACH (Cur, Head) {
+      Fragment = NET_LIST_USER_STRUCT (Cur, NET_BUF, List);
+
+      if (This->Start < IP4_GET_CLIP_INFO (Fragment)->Start) {
+        break;
+      }
     }
   }
 
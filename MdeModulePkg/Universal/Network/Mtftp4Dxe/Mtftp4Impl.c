@@ -81,6 +81,10 @@ Mtftp4CleanOperation (
 
   Instance->BlkSize       = MTFTP4_DEFAULT_BLKSIZE;
   Instance->LastBlock     = 0;
+  Instance->WindowSize    = MTFTP4_DEFAULT_WINDOWSIZE;
+  Instance->TotalBlock    = 0;
+  Instance->AckedBlock    = 0;
+  Instance->LastSentBlock = 0;
   Instance->ServerIp      = 0;
   Instance->ListeningPort = 0;
   Instance->ConnectedPort = 0;
@@ -432,6 +436,18 @@ Mtftp4Start (
     if (EFI_ERROR (Status)) {
       goto ON_ERROR;
     }
+
+    //
+    // A window of blocks may have to be sent again from any block in it,
+    // which the PacketNeeded callback can't provide. So windowed upload
+    // requires the data to be in the user's buffer.
+    //
+    if ((Operation == EFI_MTFTP4_OPCODE_WRQ) && (Token->Buffer == NULL) &&
+        ((Instance->RequestOption.Exist & MTFTP4_WINDOWSIZE_EXIST) != 0) &&
+        (Instance->RequestOption.WindowSize > 1)) {
+      Status = EFI_UNSUPPORTED;
+      goto ON_ERROR;
+    }
   }
 
   //
@@ -440,6 +456,7 @@ Mtftp4Start (
   Config                  = &Instance->Config;
   Instance->Token         = Token;
   Instance->BlkSize       = MTFTP4_DEFAULT_BLKSIZE;
+  Instance->WindowSize    = MTFTP4_DEFAULT_WINDOWSIZE;
 
   CopyMem (&Instance->ServerIp, &Config->ServerIp, sizeof (IP4_ADDR));
   Instance->ServerIp      = NTOHL (Instance->ServerIp);
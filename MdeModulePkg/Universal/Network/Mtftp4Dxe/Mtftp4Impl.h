@@ -56,6 +56,7 @@ typedef struct _MTFTP4_PROTOCOL MTFTP4_PROTOCOL;
 #define MTFTP4_DEFAULT_TIMEOUT      3
 #define MTFTP4_DEFAULT_RETRY        5
 #define MTFTP4_DEFAULT_BLKSIZE      512
+#define MTFTP4_DEFAULT_WINDOWSIZE   1
 #define MTFTP4_TIME_TO_GETMAP       5
 
 #define MTFTP4_STATE_UNCONFIGED     0
@@ -120,6 +121,16 @@ struct _MTFTP4_PROTOCOL {
   UINT16                        LastBlock;
   LIST_ENTRY                    Blocks;
 
+  //
+  // Windowsize (RFC 7440) state. For download, TotalBlock is the continuous
+  // number of the last block received and AckedBlock is that of the last
+  // block acknowledged. For upload, LastSentBlock is the last block sent.
+  //
+  UINT16                        WindowSize;
+  UINT64                        TotalBlock;
+  UINT64                        AckedBlock;
+  UINT16                        LastSentBlock;
+
   //
   // The server's communication end point: IP and two ports. one for
   // initial request, one for its selected port.
@@ -115,6 +115,8 @@ Mtftp4RrqSendAck (
   Ack->Ack.OpCode   = HTONS (EFI_MTFTP4_OPCODE_ACK);
   Ack->Ack.Block[0] = HTONS (BlkNo);
 
+  Instance->AckedBlock = Instance->TotalBlock;
+
   return Mtftp4SendPacket (Instance, Packet);
 }
 
@@ -178,6 +180,8 @@ Mtftp4RrqSaveBlock (
     return Status;
   }
 
+  Instance->TotalBlock = TotalBlock;
+
   if (Token->CheckPacket != NULL) {
     Status = Token->CheckPacket (&Instance->Mtftp4, Token, (UINT16) Len, Packet);
 
@@ -267,8 +271,17 @@ Mtftp4RrqHandleData (
   // the last ACK then restart receiving. If we are passive, save
   // the block.
   //
+  // With a window larger than one, the server restarts the window
+  // after the last block we acknowledge. So ACK the last block
+  // received in order, once, and drop the rest of the broken window.
+  //
   if (Instance->Master && (Expected != BlockNum)) {
-    Mtftp4Retransmit (Instance);
+    if (Instance->WindowSize == 1) {
+      Mtftp4Retransmit (Instance);
+    } else if (Instance->AckedBlock != Instance->TotalBlock) {
+      return Mtftp4RrqSendAck (Instance, (UINT16) (Expected - 1));
+    }
+
     return EFI_SUCCESS;
   }
 
@@ -280,9 +293,10 @@ Mtftp4RrqHandleData (
 
   //
   // Reset the passive client's timer whenever it received a
-  // valid data packet.
+  // valid data packet. So does the active client in the middle
+  // of a window, as it doesn't send an ACK for every block.
   //
-  if (!Instance->Master) {
+  if (!Instance->Master || (Instance->WindowSize > 1)) {
     Mtftp4SetTimeout (Instance);
   }
 
@@ -309,7 +323,14 @@ Mtftp4RrqHandleData (
       BlockNum = (UINT16) (Expected - 1);
     }
 
-    Mtftp4RrqSendAck (Instance, BlockNum);
+    //
+    // Only ACK the last block of a window, unless all the blocks
+    // have been received.
+    //
+    if ((Expected < 0) ||
+        (Instance->TotalBlock - Instance->AckedBlock >= Instance->WindowSize)) {
+      Mtftp4RrqSendAck (Instance, BlockNum);
+    }
   }
 
   return EFI_SUCCESS;
@@ -324,6 +345,7 @@ Mtftp4RrqHandleData (
   2. The server can only use smaller blksize than that is requested
   3. The server can only use the same timeout as requested
   4. The server doesn't change its multicast channel.
+  5. The server can only use smaller windowsize than that is requested
 
   @param  This                  The downloading Mtftp session
   @param  Reply                 The options in the OACK packet
@@ -357,6 +379,11 @@ Mtftp4RrqOackValid (
     return FALSE;
   }
 
+  if (((Reply->Exist & MTFTP4_WINDOWSIZE_EXIST) != 0) &&
+      (Reply->WindowSize > Request->WindowSize)) {
+    return FALSE;
+  }
+
   //
   // The server can send ",,master" to client to change its master
   // setting. But if it use the specific multicast channel, it can't
@@ -602,6 +629,10 @@ Mtftp4RrqHandleOack (
       if (Reply.Timeout != 0) {
         Instance->Timeout = Reply.Timeout;
       }  
+
+      if (Reply.WindowSize != 0) {
+        Instance->WindowSize = Reply.WindowSize;
+      }
     }    
     
   } else {
@@ -614,6 +645,10 @@ Mtftp4RrqHandleOack (
     if (Reply.Timeout != 0) {
       Instance->Timeout = Reply.Timeout;
     }
+
+    if (Reply.WindowSize != 0) {
+      Instance->WindowSize = Reply.WindowSize;
+    }
   }
   
   //
@@ -122,8 +122,9 @@ Mtftp4WrqSendBlock (
 /**
   Function to handle received ACK packet. 
   
-  If the ACK number matches the expected block number, and there are more 
-  data pending, send the next block. Otherwise tell the caller that we are done.
+  If the ACK number is within the blocks sent but not yet acknowledged, and
+  there are more data pending, send the next window of blocks. Otherwise tell
+  the caller that we are done.
 
   @param  Instance              The MTFTP upload session
   @param  Packet                The MTFTP packet received
@@ -146,6 +147,9 @@ Mtftp4WrqHandleAck (
   UINT16                    AckNum;
   INTN                      Expected;
   UINT64                    TotalBlock;
+  UINT16                    BlockNum;
+  UINT16                    Index;
+  EFI_STATUS                Status;
  
   *Completed  = FALSE;
   AckNum      = NTOHS (Packet->Ack.Block[0]);
@@ -155,20 +159,24 @@ Mtftp4WrqHandleAck (
 
   //
   // Get an unwanted ACK, return EFI_SUCCESS to let Mtftp4WrqInput
-  // restart receive.
+  // restart receive. With a window, the server acknowledges the last
+  // block it received in order, which is between Expected and the
+  // last block sent.
   //
-  if (Expected != AckNum) {
+  if ((AckNum < Expected) || (AckNum > Instance->LastSentBlock)) {
     return EFI_SUCCESS;
   }
 
   //
-  // Remove the acked block number, if this is the last block number,
+  // Remove the acked block numbers, if this is the last block number,
   // tell the Mtftp4WrqInput to finish the transfer. This is the last
   // block number if the block range are empty..
   //
-  Mtftp4RemoveBlockNum (&Instance->Blocks, AckNum, *Completed,&TotalBlock);
-
-  Expected = Mtftp4GetNextBlockNum (&Instance->Blocks);
+  do {
+    BlockNum = (UINT16) Expected;
+    Mtftp4RemoveBlockNum (&Instance->Blocks, BlockNum, *Completed, &TotalBlock);
+    Expected = Mtftp4GetNextBlockNum (&Instance->Blocks);
+  } while ((BlockNum != AckNum) && (Expected >= 0));
 
   if (Expected < 0) {
   
@@ -193,7 +201,27 @@ Mtftp4WrqHandleAck (
     }
   }
 
-  return Mtftp4WrqSendBlock (Instance, (UINT16) Expected);
+  //
+  // Send the next window of blocks. Blocks the server didn't acknowledge
+  // are sent again. Stop after the last block, which is known once it
+  // has been read.
+  //
+  for (Index = 0; Index < Instance->WindowSize; Index++) {
+    BlockNum = (UINT16) (Expected + Index);
+    Status   = Mtftp4WrqSendBlock (Instance, BlockNum);
+
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    Instance->LastSentBlock = BlockNum;
+
+    if ((Instance->LastBlock == BlockNum) || (BlockNum == 0xffff)) {
+      break;
+    }
+  }
+
+  return EFI_SUCCESS;
 }
 
 
@@ -204,7 +232,8 @@ Mtftp4WrqHandleAck (
   1. It only include options requested by us
   2. It can only include a smaller block size
   3. It can't change the proposed time out value.
-  4. Other requirements of the individal MTFTP options as required.
+  4. It can only include a smaller window size
+  5. Other requirements of the individal MTFTP options as required.
 
   @param  Reply                 The options included in the OACK
   @param  Request               The options we requested
@@ -235,6 +264,11 @@ Mtftp4WrqOackValid (
     return FALSE;
   }
 
+  if (((Reply->Exist & MTFTP4_WINDOWSIZE_EXIST) != 0) &&
+      (Reply->WindowSize > Request->WindowSize)) {
+    return FALSE;
+  }
+
   return TRUE;
 }
 
@@ -308,6 +342,10 @@ Mtftp4WrqHandleOack (
     Instance->Timeout = Reply.Timeout;
   }
 
+  if (Reply.WindowSize != 0) {
+    Instance->WindowSize = Reply.WindowSize;
+  }
+
   //
   // Build a bogus ACK0 packet then pass it to the Mtftp4WrqHandleAck,
   // which will start the transmission of the first data block.
@@ -2502,6 +2502,260 @@ Done:
   return GetTheVal;
 }
 
+/**
+  Find the Question read by a compiled expression.
+
+  The Question must be unique in the formset, so that it is the Question
+  IdToQuestion() returns whichever form the expression is evaluated for.
+
+  @param  FormSet                FormSet associated with the expression.
+  @param  QuestionId             Id of the Question.
+
+  @retval Pointer                The Question.
+  @retval NULL                   The Question is not found, or is not unique.
+
+**/
+FORM_BROWSER_STATEMENT *
+IdToDependencyQuestion (
+  IN FORM_BROWSER_FORMSET  *FormSet,
+  IN EFI_QUESTION_ID       QuestionId
+  )
+{
+  LIST_ENTRY              *FormLink;
+  LIST_ENTRY              *Link;
+  FORM_BROWSER_FORM       *Form;
+  FORM_BROWSER_STATEMENT  *Statement;
+  FORM_BROWSER_STATEMENT  *Question;
+
+  if (QuestionId == 0) {
+    return NULL;
+  }
+
+  Question = NULL;
+  FormLink = GetFirstNode (&FormSet->FormListHead);
+  while (!IsNull (&FormSet->FormListHead, FormLink)) {
+    Form = FORM_BROWSER_FORM_FROM_LINK (FormLink);
+    FormLink = GetNextNode (&FormSet->FormListHead, FormLink);
+
+    Link = GetFirstNode (&Form->StatementListHead);
+    while (!IsNull (&Form->StatementListHead, Link)) {
+      Statement = FORM_BROWSER_STATEMENT_FROM_LINK (Link);
+      Link = GetNextNode (&Form->StatementListHead, Link);
+
+      if (Statement->QuestionId == QuestionId) {
+        if (Question != NULL) {
+          return NULL;
+        }
+        Question = Statement;
+      }
+    }
+  }
+
+  return Question;
+}
+
+/**
+  Compile an expression after its formset is parsed.
+
+  An expression made only of constants, arithmetic and logical operators and
+  references to numeric, boolean, date or time Questions gives the same result
+  as long as those Questions keep their values. Such an expression is marked
+  cacheable and the Questions it reads are saved in its Dependency array, so
+  that EvaluateExpression() only evaluates it again after one of them changed.
+  Any other expression, for instance one reading a storage, a string or a rule,
+  is evaluated every time as before.
+
+  @param  FormSet                FormSet associated with this expression.
+  @param  Expression             Expression to be compiled.
+
+**/
+VOID
+CompileExpression (
+  IN FORM_BROWSER_FORMSET  *FormSet,
+  IN OUT FORM_EXPRESSION   *Expression
+  )
+{
+  LIST_ENTRY              *Link;
+  EXPRESSION_OPCODE       *OpCode;
+  FORM_BROWSER_STATEMENT  *Question;
+  EFI_QUESTION_ID         QuestionId[2];
+  UINTN                   QuestionCount;
+  UINTN                   Count;
+  UINTN                   Index;
+  UINTN                   DependencyIndex;
+
+  if (Expression->Dependency != NULL) {
+    FreePool (Expression->Dependency);
+    Expression->Dependency = NULL;
+  }
+  Expression->Cacheable       = FALSE;
+  Expression->ResultValid     = FALSE;
+  Expression->DependencyCount = 0;
+
+  //
+  // Check the OpCodes and count the Question references.
+  //
+  Count = 0;
+  Link = GetFirstNode (&Expression->OpCodeListHead);
+  while (!IsNull (&Expression->OpCodeListHead, Link)) {
+    OpCode = EXPRESSION_OPCODE_FROM_LINK (Link);
+    Link = GetNextNode (&Expression->OpCodeListHead, Link);
+
+    switch (OpCode->Operand) {
+    case EFI_IFR_EQ_ID_ID_OP:
+      Count += 2;
+      break;
+
+    case EFI_IFR_EQ_ID_VAL_OP:
+    case EFI_IFR_EQ_ID_VAL_LIST_OP:
+    case EFI_IFR_QUESTION_REF1_OP:
+    case EFI_IFR_THIS_OP:
+      Count++;
+      break;
+
+    case EFI_IFR_DUP_OP:
+    case EFI_IFR_TRUE_OP:
+    case EFI_IFR_FALSE_OP:
+    case EFI_IFR_ONE_OP:
+    case EFI_IFR_ONES_OP:
+    case EFI_IFR_UINT8_OP:
+    case EFI_IFR_UINT16_OP:
+    case EFI_IFR_UINT32_OP:
+    case EFI_IFR_UINT64_OP:
+    case EFI_IFR_UNDEFINED_OP:
+    case EFI_IFR_VERSION_OP:
+    case EFI_IFR_ZERO_OP:
+    case EFI_IFR_NOT_OP:
+    case EFI_IFR_BITWISE_NOT_OP:
+    case EFI_IFR_TO_BOOLEAN_OP:
+    case EFI_IFR_ADD_OP:
+    case EFI_IFR_SUBTRACT_OP:
+    case EFI_IFR_MULTIPLY_OP:
+    case EFI_IFR_DIVIDE_OP:
+    case EFI_IFR_MODULO_OP:
+    case EFI_IFR_BITWISE_AND_OP:
+    case EFI_IFR_BITWISE_OR_OP:
+    case EFI_IFR_SHIFT_LEFT_OP:
+    case EFI_IFR_SHIFT_RIGHT_OP:
+    case EFI_IFR_AND_OP:
+    case EFI_IFR_OR_OP:
+    case EFI_IFR_EQUAL_OP:
+    case EFI_IFR_NOT_EQUAL_OP:
+    case EFI_IFR_GREATER_THAN_OP:
+    case EFI_IFR_GREATER_EQUAL_OP:
+    case EFI_IFR_LESS_THAN_OP:
+    case EFI_IFR_LESS_EQUAL_OP:
+    case EFI_IFR_CONDITIONAL_OP:
+      break;
+
+    default:
+      //
+      // The result may change without any Question value change.
+      //
+      return;
+    }
+  }
+
+  if (Count != 0) {
+    Expression->Dependency = AllocateZeroPool (Count * sizeof (EXPRESSION_DEPENDENCY));
+    if (Expression->Dependency == NULL) {
+      return;
+    }
+  }
+
+  //
+  // Resolve the Questions read by the expression.
+  //
+  Link = GetFirstNode (&Expression->OpCodeListHead);
+  while (!IsNull (&Expression->OpCodeListHead, Link)) {
+    OpCode = EXPRESSION_OPCODE_FROM_LINK (Link);
+    Link = GetNextNode (&Expression->OpCodeListHead, Link);
+
+    switch (OpCode->Operand) {
+    case EFI_IFR_EQ_ID_ID_OP:
+      QuestionId[0] = OpCode->QuestionId;
+      QuestionId[1] = OpCode->QuestionId2;
+      QuestionCount = 2;
+      break;
+
+    case EFI_IFR_EQ_ID_VAL_OP:
+    case EFI_IFR_EQ_ID_VAL_LIST_OP:
+    case EFI_IFR_QUESTION_REF1_OP:
+    case EFI_IFR_THIS_OP:
+      QuestionId[0] = OpCode->QuestionId;
+      QuestionCount = 1;
+      break;
+
+    default:
+      QuestionCount = 0;
+      break;
+    }
+
+    for (Index = 0; Index < QuestionCount; Index++) {
+      Question = IdToDependencyQuestion (FormSet, QuestionId[Index]);
+
+      //
+      // IdToQuestion() reloads the Questions of EFI variable storage, and the
+      // value of string and buffer Questions is not held in HiiValue.
+      //
+      if ((Question == NULL) ||
+          ((Question->Storage != NULL) && (Question->Storage->Type == EFI_HII_VARSTORE_EFI_VARIABLE)) ||
+          ((Question->HiiValue.Type > EFI_IFR_TYPE_DATE) && (Question->HiiValue.Type != EFI_IFR_TYPE_REF))) {
+        FreePool (Expression->Dependency);
+        Expression->Dependency      = NULL;
+        Expression->DependencyCount = 0;
+        return;
+      }
+
+      for (DependencyIndex = 0; DependencyIndex < Expression->DependencyCount; DependencyIndex++) {
+        if (Expression->Dependency[DependencyIndex].Question == Question) {
+          break;
+        }
+      }
+      if (DependencyIndex == Expression->DependencyCount) {
+        Expression->Dependency[Expression->DependencyCount].Question = Question;
+        Expression->DependencyCount++;
+      }
+    }
+  }
+
+  Expression->Cacheable = TRUE;
+}
+
+/**
+  Check whether the result of an expression is still up to date, that is,
+  whether the Questions it reads kept their values since it was evaluated.
+
+  @param  Expression             The compiled expression.
+
+  @retval TRUE                   The saved result can be used.
+  @retval FALSE                  The expression needs to be evaluated.
+
+**/
+BOOLEAN
+IsExpressionResultCurrent (
+  IN FORM_EXPRESSION   *Expression
+  )
+{
+  UINTN                   Index;
+
+  if (!Expression->Cacheable || !Expression->ResultValid) {
+    return FALSE;
+  }
+
+  for (Index = 0; Index < Expression->DependencyCount; Index++) {
+    if (CompareMem (
+          &Expression->Dependency[Index].Value,
+          &Expression->Dependency[Index].Question->HiiValue,
+          sizeof (EFI_HII_VALUE)
+          ) != 0) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
 /**
   Evaluate the result of a HII expression.
 
@@ -2555,12 +2809,20 @@ EvaluateExpression (
 
   StrPtr = NULL;
 
+  ASSERT (Expression != NULL);
+
+  //
+  // Skip the compiled expression if none of the Questions it reads changed.
+  //
+  if (IsExpressionResultCurrent (Expression)) {
+    return EFI_SUCCESS;
+  }
+
   //
   // Save current stack offset.
   //
   StackOffset = SaveExpressionEvaluationStackOffset ();
 
-  ASSERT (Expression != NULL);
   Expression->Result.Type = EFI_IFR_TYPE_OTHER;
 
   Link = GetFirstNode (&Expression->OpCodeListHead);
@@ -3611,6 +3873,22 @@ Done:
     CopyMem (&Expression->Result, Value, sizeof (EFI_HII_VALUE));
   }
 
+  //
+  // Save the values the result was computed from. Only a scalar result is
+  // kept, the others may refer to buffers owned by the caller.
+  //
+  Expression->ResultValid = FALSE;
+  if (Expression->Cacheable && !EFI_ERROR (Status) && Expression->Result.Type <= EFI_IFR_TYPE_DATE) {
+    for (Index = 0; Index < Expression->DependencyCount; Index++) {
+      CopyMem (
+        &Expression->Dependency[Index].Value,
+        &Expression->Dependency[Index].Question->HiiValue,
+        sizeof (EFI_HII_VALUE)
+        );
+    }
+    Expression->ResultValid = TRUE;
+  }
+
   return Status;
 }
 
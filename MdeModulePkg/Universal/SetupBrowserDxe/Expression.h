@@ -224,6 +224,24 @@ EvaluateExpression (
   IN FORM_BROWSER_FORM     *Form,
   IN OUT FORM_EXPRESSION   *Expression
   );
+
+/**
+  Compile an expression after its formset is parsed.
+
+  An expression made only of constants, arithmetic and logical operators and
+  references to numeric, boolean, date or time Questions is marked cacheable,
+  and the Questions it reads are saved in its Dependency array. It is then
+  only evaluated again after one of those Questions changed its value.
+
+  @param  FormSet                FormSet associated with this expression.
+  @param  Expression             Expression to be compiled.
+
+**/
+VOID
+CompileExpression (
+  IN FORM_BROWSER_FORMSET  *FormSet,
+  IN OUT FORM_EXPRESSION   *Expression
+  );
 /**
   Return the result of the expression list. Check the expression list and 
   return the highest priority express result.  
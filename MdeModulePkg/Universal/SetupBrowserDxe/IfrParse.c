@@ -853,6 +853,10 @@ DestroyExpression (
     }
   }
 
+  if (Expression->Dependency != NULL) {
+    FreePool (Expression->Dependency);
+  }
+
   //
   // Free this Expression
   //
@@ -1260,6 +1264,42 @@ CountOpCodes (
 
 
 
+/**
+  Compile the form and formset level expressions of a parsed formset, so
+  that refreshing a form only evaluates the expressions whose Questions
+  changed their values.
+
+  @param  FormSet                Pointer of the FormSet data structure.
+
+**/
+VOID
+CompileFormSetExpressions (
+  IN FORM_BROWSER_FORMSET  *FormSet
+  )
+{
+  LIST_ENTRY         *FormLink;
+  LIST_ENTRY         *Link;
+  FORM_BROWSER_FORM  *Form;
+
+  Link = GetFirstNode (&FormSet->ExpressionListHead);
+  while (!IsNull (&FormSet->ExpressionListHead, Link)) {
+    CompileExpression (FormSet, FORM_EXPRESSION_FROM_LINK (Link));
+    Link = GetNextNode (&FormSet->ExpressionListHead, Link);
+  }
+
+  FormLink = GetFirstNode (&FormSet->FormListHead);
+  while (!IsNull (&FormSet->FormListHead, FormLink)) {
+    Form = FORM_BROWSER_FORM_FROM_LINK (FormLink);
+    FormLink = GetNextNode (&FormSet->FormListHead, FormLink);
+
+    Link = GetFirstNode (&Form->ExpressionListHead);
+    while (!IsNull (&Form->ExpressionListHead, Link)) {
+      CompileExpression (FormSet, FORM_EXPRESSION_FROM_LINK (Link));
+      Link = GetNextNode (&Form->ExpressionListHead, Link);
+    }
+  }
+}
+
 /**
   Parse opcodes in the formset IFR binary.
 
@@ -2724,5 +2764,7 @@ ParseOpCodes (
     }
   }
 
+  CompileFormSetExpressions (FormSet);
+
   return EFI_SUCCESS;
 }
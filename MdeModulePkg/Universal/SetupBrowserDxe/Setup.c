@@ -51,6 +51,8 @@ LIST_ENTRY      gBrowserFormSetList = INITIALIZE_LIST_HEAD_VARIABLE (gBrowserFor
 LIST_ENTRY      gBrowserHotKeyList  = INITIALIZE_LIST_HEAD_VARIABLE (gBrowserHotKeyList);
 LIST_ENTRY      gBrowserStorageList = INITIALIZE_LIST_HEAD_VARIABLE (gBrowserStorageList);
 LIST_ENTRY      gBrowserSaveFailFormSetList = INITIALIZE_LIST_HEAD_VARIABLE (gBrowserSaveFailFormSetList);
+LIST_ENTRY      mFormSetIfrCacheList = INITIALIZE_LIST_HEAD_VARIABLE (mFormSetIfrCacheList);
+BOOLEAN         mFormSetIfrCacheEnabled = FALSE;
 
 BOOLEAN               mSystemSubmit = FALSE;
 BOOLEAN               gResetRequired;
@@ -946,6 +948,8 @@ InitializeSetup (
 
   InitializeDisplayFormData ();
 
+  InitializeFormSetIfrCache ();
+
   Status = gBS->LocateProtocol (
                   &gEdkiiFormDisplayEngineProtocolGuid,
                   NULL,
@@ -5300,6 +5304,225 @@ InitializeCurrentSetting (
 }
 
 
+/**
+  Remove an entry from the FormSet IFR binary cache and free it.
+
+  @param  CacheEntry             The cache entry.
+
+**/
+VOID
+FreeFormSetIfrCache (
+  IN FORMSET_IFR_CACHE         *CacheEntry
+  )
+{
+  RemoveEntryList (&CacheEntry->Link);
+  if (CacheEntry->IfrBinaryData != NULL) {
+    FreePool (CacheEntry->IfrBinaryData);
+  }
+  FreePool (CacheEntry);
+}
+
+
+/**
+  Drop the cached FormSet IFR binaries of a package list when its form
+  packages are added, updated or removed.
+
+  @param PackageType  Package type of the notification.
+  @param PackageGuid  If PackageType is EFI_HII_PACKAGE_TYPE_GUID, then this is
+                      the pointer to the GUID from the Guid field of
+                      EFI_HII_PACKAGE_GUID_HEADER. Otherwise, it must be NULL.
+  @param Package      Points to the package referred to by the notification.
+  @param Handle       The HII handle.
+  @param NotifyType   The type of change concerning the database.
+
+  @retval EFI_SUCCESS The cache is updated.
+
+**/
+EFI_STATUS
+EFIAPI
+FormSetIfrCacheNotify (
+  IN UINT8                              PackageType,
+  IN CONST EFI_GUID                     *PackageGuid,
+  IN CONST EFI_HII_PACKAGE_HEADER       *Package,
+  IN EFI_HII_HANDLE                     Handle,
+  IN EFI_HII_DATABASE_NOTIFY_TYPE       NotifyType
+  )
+{
+  LIST_ENTRY                   *Link;
+  FORMSET_IFR_CACHE            *CacheEntry;
+
+  Link = GetFirstNode (&mFormSetIfrCacheList);
+  while (!IsNull (&mFormSetIfrCacheList, Link)) {
+    CacheEntry = FORMSET_IFR_CACHE_FROM_LINK (Link);
+    Link = GetNextNode (&mFormSetIfrCacheList, Link);
+
+    if (CacheEntry->HiiHandle == Handle) {
+      FreeFormSetIfrCache (CacheEntry);
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+
+/**
+  Register the package notifications which keep the FormSet IFR binary cache
+  in sync with the HII database. The cache is not used if they cannot be
+  registered.
+
+**/
+VOID
+InitializeFormSetIfrCache (
+  VOID
+  )
+{
+  EFI_STATUS                   Status;
+  EFI_HANDLE                   NotifyHandle;
+
+  //
+  // HiiUpdatePackageList() removes the old form packages and adds the new
+  // ones, HiiNewPackageList() always creates a new handle.
+  //
+  Status = mHiiDatabase->RegisterPackageNotify (
+                           mHiiDatabase,
+                           EFI_HII_PACKAGE_FORMS,
+                           NULL,
+                           FormSetIfrCacheNotify,
+                           EFI_HII_DATABASE_NOTIFY_REMOVE_PACK,
+                           &NotifyHandle
+                           );
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  Status = mHiiDatabase->RegisterPackageNotify (
+                           mHiiDatabase,
+                           EFI_HII_PACKAGE_FORMS,
+                           NULL,
+                           FormSetIfrCacheNotify,
+                           EFI_HII_DATABASE_NOTIFY_ADD_PACK,
+                           &NotifyHandle
+                           );
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  mFormSetIfrCacheEnabled = TRUE;
+}
+
+
+/**
+  Look up the IFR binary of a FormSet in the cache, and return a copy of it.
+
+  @param  Handle                 PackageList Handle
+  @param  RequestGuid            GUID or class GUID of a formset, zero GUID if not
+                                 specified.
+  @param  FormSetGuid            If not NULL, GUID of the formset found.
+  @param  BinaryLength           The length of the FormSet IFR binary.
+  @param  BinaryData             The buffer designed to receive the FormSet.
+
+  @retval TRUE                   The FormSet IFR binary is returned from the cache.
+  @retval FALSE                  The FormSet IFR binary is not in the cache.
+
+**/
+BOOLEAN
+GetIfrBinaryDataFromCache (
+  IN  EFI_HII_HANDLE   Handle,
+  IN  EFI_GUID         *RequestGuid,
+  OUT EFI_GUID         *FormSetGuid,
+  OUT UINTN            *BinaryLength,
+  OUT UINT8            **BinaryData
+  )
+{
+  LIST_ENTRY                   *Link;
+  FORMSET_IFR_CACHE            *CacheEntry;
+
+  Link = GetFirstNode (&mFormSetIfrCacheList);
+  while (!IsNull (&mFormSetIfrCacheList, Link)) {
+    CacheEntry = FORMSET_IFR_CACHE_FROM_LINK (Link);
+
+    if (CacheEntry->HiiHandle == Handle && CompareGuid (&CacheEntry->RequestGuid, RequestGuid)) {
+      *BinaryData = AllocateCopyPool (CacheEntry->IfrBinaryLength, CacheEntry->IfrBinaryData);
+      if (*BinaryData == NULL) {
+        return FALSE;
+      }
+      *BinaryLength = CacheEntry->IfrBinaryLength;
+      if (FormSetGuid != NULL) {
+        CopyGuid (FormSetGuid, &CacheEntry->FormSetGuid);
+      }
+
+      //
+      // Keep the most recently used entry at the head of the list.
+      //
+      RemoveEntryList (&CacheEntry->Link);
+      InsertHeadList (&mFormSetIfrCacheList, &CacheEntry->Link);
+      return TRUE;
+    }
+
+    Link = GetNextNode (&mFormSetIfrCacheList, Link);
+  }
+
+  return FALSE;
+}
+
+
+/**
+  Add a copy of the IFR binary of a FormSet to the cache. The least recently
+  used entry is freed when the cache is full. Failing to cache the binary is
+  not an error.
+
+  @param  Handle                 PackageList Handle
+  @param  RequestGuid            GUID or class GUID of a formset, zero GUID if not
+                                 specified.
+  @param  FormSetGuid            GUID of the formset found.
+  @param  BinaryLength           The length of the FormSet IFR binary.
+  @param  BinaryData             The FormSet IFR binary.
+
+**/
+VOID
+AddIfrBinaryDataToCache (
+  IN EFI_HII_HANDLE   Handle,
+  IN EFI_GUID         *RequestGuid,
+  IN EFI_GUID         *FormSetGuid,
+  IN UINTN            BinaryLength,
+  IN UINT8            *BinaryData
+  )
+{
+  FORMSET_IFR_CACHE            *CacheEntry;
+  LIST_ENTRY                   *Link;
+  UINTN                        Count;
+
+  CacheEntry = AllocateZeroPool (sizeof (FORMSET_IFR_CACHE));
+  if (CacheEntry == NULL) {
+    return;
+  }
+
+  CacheEntry->IfrBinaryData = AllocateCopyPool (BinaryLength, BinaryData);
+  if (CacheEntry->IfrBinaryData == NULL) {
+    FreePool (CacheEntry);
+    return;
+  }
+
+  CacheEntry->Signature       = FORMSET_IFR_CACHE_SIGNATURE;
+  CacheEntry->HiiHandle       = Handle;
+  CacheEntry->IfrBinaryLength = BinaryLength;
+  CopyGuid (&CacheEntry->RequestGuid, RequestGuid);
+  CopyGuid (&CacheEntry->FormSetGuid, FormSetGuid);
+  InsertHeadList (&mFormSetIfrCacheList, &CacheEntry->Link);
+
+  //
+  // Free the least recently used entry at the tail of the list.
+  //
+  Count = 0;
+  for (Link = GetFirstNode (&mFormSetIfrCacheList); !IsNull (&mFormSetIfrCacheList, Link); Link = GetNextNode (&mFormSetIfrCacheList, Link)) {
+    Count++;
+  }
+  if (Count > FORMSET_IFR_CACHE_MAX_ENTRIES) {
+    FreeFormSetIfrCache (FORMSET_IFR_CACHE_FROM_LINK (GetPreviousNode (&mFormSetIfrCacheList, &mFormSetIfrCacheList)));
+  }
+}
+
+
 /**
   Fetch the Ifr binary data of a FormSet.
 
@@ -5341,6 +5564,7 @@ GetIfrBinaryData (
   BOOLEAN                      ClassGuidMatch;
   EFI_GUID                     *ClassGuid;
   EFI_GUID                     *ComparingGuid;
+  EFI_GUID                     RequestGuid;
 
   OpCodeData = NULL;
   Package = NULL;
@@ -5355,6 +5579,16 @@ GetIfrBinaryData (
     ComparingGuid = FormSetGuid;
   }
 
+  //
+  // Exporting the package list copies all its packages, use the FormSet
+  // IFR binary cached since the form packages were last changed instead.
+  //
+  CopyGuid (&RequestGuid, ComparingGuid);
+  if (mFormSetIfrCacheEnabled &&
+      GetIfrBinaryDataFromCache (Handle, &RequestGuid, FormSetGuid, BinaryLength, BinaryData)) {
+    return EFI_SUCCESS;
+  }
+
   //
   // Get HII PackageList
   //
@@ -5465,6 +5699,16 @@ GetIfrBinaryData (
     return EFI_OUT_OF_RESOURCES;
   }
 
+  if (mFormSetIfrCacheEnabled) {
+    AddIfrBinaryDataToCache (
+      Handle,
+      &RequestGuid,
+      &((EFI_IFR_FORM_SET *) *BinaryData)->Guid,
+      *BinaryLength,
+      *BinaryData
+      );
+  }
+
   return EFI_SUCCESS;
 }
 
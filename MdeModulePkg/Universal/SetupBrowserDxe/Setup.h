@@ -221,6 +221,14 @@ typedef struct {
 
 #define EXPRESSION_OPCODE_FROM_LINK(a)  CR (a, EXPRESSION_OPCODE, Link, EXPRESSION_OPCODE_SIGNATURE)
 
+//
+// A Question read by an expression, and its value when the expression was last evaluated.
+//
+typedef struct {
+  struct _FORM_BROWSER_STATEMENT *Question;
+  EFI_HII_VALUE                  Value;
+} EXPRESSION_DEPENDENCY;
+
 #define FORM_EXPRESSION_SIGNATURE  SIGNATURE_32 ('F', 'E', 'X', 'P')
 
 typedef struct {
@@ -238,6 +246,11 @@ typedef struct {
   EFI_IFR_OP_HEADER *OpCode;         // Save the opcode buffer.
 
   LIST_ENTRY        OpCodeListHead;  // OpCodes consist of this expression (EXPRESSION_OPCODE)
+
+  BOOLEAN           Cacheable;       // Result only depends on the values of the Dependency Questions
+  BOOLEAN           ResultValid;     // Result is up to date with the values saved in Dependency
+  UINTN             DependencyCount;
+  EXPRESSION_DEPENDENCY *Dependency; // Questions read by this expression, set by CompileExpression()
 } FORM_EXPRESSION;
 
 #define FORM_EXPRESSION_FROM_LINK(a)  CR (a, FORM_EXPRESSION, Link, FORM_EXPRESSION_SIGNATURE)
@@ -548,6 +561,26 @@ typedef struct {
 
 #define BROWSER_CONTEXT_FROM_LINK(a)  CR (a, BROWSER_CONTEXT, Link, BROWSER_CONTEXT_SIGNATURE)
 
+#define FORMSET_IFR_CACHE_SIGNATURE  SIGNATURE_32 ('F', 'I', 'F', 'C')
+
+//
+// Maximum number of FormSet IFR binaries kept in the cache.
+//
+#define FORMSET_IFR_CACHE_MAX_ENTRIES  32
+
+typedef struct {
+  UINTN                 Signature;
+  LIST_ENTRY            Link;
+
+  EFI_HII_HANDLE        HiiHandle;
+  EFI_GUID              RequestGuid;      // GUID or class GUID asked for, zero GUID if not specified
+  EFI_GUID              FormSetGuid;      // GUID of the FormSet found
+  UINTN                 IfrBinaryLength;
+  UINT8                 *IfrBinaryData;
+} FORMSET_IFR_CACHE;
+
+#define FORMSET_IFR_CACHE_FROM_LINK(a)  CR (a, FORMSET_IFR_CACHE, Link, FORMSET_IFR_CACHE_SIGNATURE)
+
 //
 // Scope for get defaut value. It may be GetDefaultForNoStorage, GetDefaultForStorage or GetDefaultForAll.
 //
@@ -1062,6 +1095,17 @@ GetIfrBinaryData (
   OUT UINT8            **BinaryData
   );
 
+/**
+  Register the package notifications which keep the FormSet IFR binary cache
+  in sync with the HII database. The cache is not used if they cannot be
+  registered.
+
+**/
+VOID
+InitializeFormSetIfrCache (
+  VOID
+  );
+
 /**
   Save globals used by previous call to SendForm(). SendForm() may be called from 
   HiiConfigAccess.Callback(), this will cause SendForm() be reentried.
@@ -230,11 +230,20 @@ Ip6Reassemble (
   //
   ListHead = &Assemble->Fragments;
 
-  NET_LIST_FOR_EACH (Cur, ListHead) {
-    Fragment = NET_LIST_USER_STRUCT (Cur, NET_BUF, List);
+  //
+  // Fragments of a large datagram normally arrive in order. Check the
+  // tail first, so appending such a fragment doesn't walk the whole list.
+  //
+  Cur = ListHead;
 
-    if (This->Start < IP6_GET_CLIP_INFO (Fragment)->Start) {
-      break;
+  if (!IsListEmpty (ListHead) &&
+      (This->Start < IP6_GET_CLIP_INFO (NET_LIST_TAIL (ListHead, NET_BUF, List))->Start)) {
+    NET_LIST_FOR_EACH (Cur, ListHead) {
+      Fragment = NET_LIST_USER_STRUCT (Cur, NET_BUF, List);
+
+      if (This->Start < IP6_GET_CLIP_INFO (Fragment)->Start) {
+        break;
+      }
     }
   }
 
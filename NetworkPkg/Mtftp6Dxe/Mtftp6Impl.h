@@ -46,6 +46,7 @@ typedef struct _MTFTP6_INSTANCE MTFTP6_INSTANCE;
 #define MTFTP6_GET_MAPPING_TIMEOUT     3
 #define MTFTP6_DEFAULT_MAX_RETRY       5
 #define MTFTP6_DEFAULT_BLK_SIZE        512
+#define MTFTP6_DEFAULT_WINDOWSIZE      1
 #define MTFTP6_TICK_PER_SECOND         10000000U
 
 #define MTFTP6_SERVICE_FROM_THIS(a)    CR (a, MTFTP6_SERVICE, ServiceBinding, MTFTP6_SERVICE_SIGNATURE)
@@ -77,6 +78,16 @@ struct _MTFTP6_INSTANCE {
   UINT16                        LastBlk;
   LIST_ENTRY                    BlkList;
 
+  //
+  // Windowsize (RFC 7440) state. For download, TotalBlock is the continuous
+  // number of the last block received and AckedBlock is that of the last
+  // block acknowledged. For upload, LastSentBlk is the last block sent.
+  //
+  UINT16                        WindowSize;
+  UINT64                        TotalBlock;
+  UINT64                        AckedBlock;
+  UINT16                        LastSentBlk;
+
   EFI_IPv6_ADDRESS              ServerIp;
   UINT16                        ServerCmdPort;
   UINT16                        ServerDataPort;
@@ -60,6 +60,7 @@ Mtftp6RrqSendAck (
   //
   Instance->CurRetry = 0;
   Instance->LastPacket = Packet;
+  Instance->AckedBlock = Instance->TotalBlock;
 
   return Mtftp6TransmitPacket (Instance, Packet);
 }
@@ -126,6 +127,8 @@ Mtftp6RrqSaveBlock (
     return Status;
   }
 
+  Instance->TotalBlock = TotalBlock;
+
   if (Token->CheckPacket != NULL) {
     //
     // Callback to the check packet routine with the received packet.
@@ -234,6 +237,10 @@ Mtftp6RrqHandleData (
   // the last ACK then restart receiving. If we are passive, save
   // the block.
   //
+  // With a window larger than one, the server restarts the window
+  // after the last block we acknowledge. So ACK the last block
+  // received in order, once, and drop the rest of the broken window.
+  //
   if (Instance->IsMaster && (Expected != BlockNum)) {
     //
     // Free the received packet before send new packet in ReceiveNotify,
@@ -242,7 +249,12 @@ Mtftp6RrqHandleData (
     NetbufFree (*UdpPacket);
     *UdpPacket = NULL;
 
-    Mtftp6TransmitPacket (Instance, Instance->LastPacket);
+    if (Instance->WindowSize == 1) {
+      Mtftp6TransmitPacket (Instance, Instance->LastPacket);
+    } else if (Instance->AckedBlock != Instance->TotalBlock) {
+      return Mtftp6RrqSendAck (Instance, (UINT16) (Expected - 1));
+    }
+
     return EFI_SUCCESS;
   }
 
@@ -254,9 +266,13 @@ Mtftp6RrqHandleData (
 
   //
   // Reset the passive client's timer whenever it received a valid data packet.
+  // So does the active client in the middle of a window, as it doesn't send
+  // an ACK for every block.
   //
   if (!Instance->IsMaster) {
     Instance->PacketToLive = Instance->Timeout * 2;
+  } else if (Instance->WindowSize > 1) {
+    Instance->PacketToLive = Instance->Timeout;
   }
 
   //
@@ -281,14 +297,22 @@ Mtftp6RrqHandleData (
     } else {
       BlockNum     = (UINT16) (Expected - 1);
     }
+
     //
-    // Free the received packet before send new packet in ReceiveNotify,
-    // since the udpio might need to be reconfigured.
+    // Only ACK the last block of a window, unless all the blocks
+    // have been received.
     //
-    NetbufFree (*UdpPacket);
-    *UdpPacket = NULL;
+    if ((Expected < 0) ||
+        (Instance->TotalBlock - Instance->AckedBlock >= Instance->WindowSize)) {
+      //
+      // Free the received packet before send new packet in ReceiveNotify,
+      // since the udpio might need to be reconfigured.
+      //
+      NetbufFree (*UdpPacket);
+      *UdpPacket = NULL;
 
-    Mtftp6RrqSendAck (Instance, BlockNum);
+      Mtftp6RrqSendAck (Instance, BlockNum);
+    }
   }
 
   return EFI_SUCCESS;
@@ -302,6 +326,7 @@ Mtftp6RrqHandleData (
   2. The server can only use smaller blksize than that is requested.
   3. The server can only use the same timeout as requested.
   4. The server doesn't change its multicast channel.
+  5. The server can only use smaller windowsize than that is requested.
 
   @param[in]  Instance              The pointer to the Mtftp6 instance.
   @param[in]  ReplyInfo             The pointer to options information in reply packet.
@@ -335,6 +360,11 @@ Mtftp6RrqOackValid (
     return FALSE;
   }
 
+  if (((ReplyInfo->BitMap & MTFTP6_OPT_WINDOWSIZE_BIT) != 0) &&
+      (ReplyInfo->WindowSize > RequestInfo->WindowSize)) {
+    return FALSE;
+  }
+
   //
   // The server can send ",,master" to client to change its master
   // setting. But if it use the specific multicast channel, it can't
@@ -615,6 +645,10 @@ Mtftp6RrqHandleOack (
       if (ExtInfo.Timeout != 0) {
         Instance->Timeout = ExtInfo.Timeout;
       }
+
+      if (ExtInfo.WindowSize != 0) {
+        Instance->WindowSize = ExtInfo.WindowSize;
+      }
     }
 
   } else {
@@ -628,6 +662,10 @@ Mtftp6RrqHandleOack (
     if (ExtInfo.Timeout != 0) {
       Instance->Timeout = ExtInfo.Timeout;
     }
+
+    if (ExtInfo.WindowSize != 0) {
+      Instance->WindowSize = ExtInfo.WindowSize;
+    }
   }
 
   //
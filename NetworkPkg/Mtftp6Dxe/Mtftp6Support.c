@@ -980,6 +980,10 @@ Mtftp6OperationClean (
   Instance->McastPort      = 0;
   Instance->BlkSize        = 0;
   Instance->LastBlk        = 0;
+  Instance->WindowSize     = 0;
+  Instance->TotalBlock     = 0;
+  Instance->AckedBlock     = 0;
+  Instance->LastSentBlk    = 0;
   Instance->PacketToLive   = 0;
   Instance->MaxRetry       = 0;
   Instance->CurRetry       = 0;
@@ -1066,6 +1070,18 @@ Mtftp6OperationStart (
     if (EFI_ERROR (Status)) {
       goto ON_ERROR;
     }
+
+    //
+    // A window of blocks may have to be sent again from any block in it,
+    // which the PacketNeeded callback can't provide. So windowed upload
+    // requires the data to be in the user's buffer.
+    //
+    if ((OpCode == EFI_MTFTP6_OPCODE_WRQ) && (Token->Buffer == NULL) &&
+        ((Instance->ExtInfo.BitMap & MTFTP6_OPT_WINDOWSIZE_BIT) != 0) &&
+        (Instance->ExtInfo.WindowSize > 1)) {
+      Status = EFI_UNSUPPORTED;
+      goto ON_ERROR;
+    }
   }
 
   //
@@ -1105,6 +1121,9 @@ Mtftp6OperationStart (
   if (Instance->BlkSize == 0) {
     Instance->BlkSize = MTFTP6_DEFAULT_BLK_SIZE;
   }
+  if (Instance->WindowSize == 0) {
+    Instance->WindowSize = MTFTP6_DEFAULT_WINDOWSIZE;
+  }
   if (Instance->MaxRetry == 0) {
     Instance->MaxRetry = MTFTP6_DEFAULT_MAX_RETRY;
   }
@@ -126,9 +126,9 @@ Mtftp6WrqSendBlock (
 
 
 /**
-  Function to handle received ACK packet. If the ACK number matches the
-  expected block number, with more data pending, send the next
-  block. Otherwise, tell the caller that we are done.
+  Function to handle received ACK packet. If the ACK number is within the
+  blocks sent but not yet acknowledged, with more data pending, send the
+  next window of blocks. Otherwise, tell the caller that we are done.
 
   @param[in]  Instance              The pointer to the Mtftp6 instance.
   @param[in]  Packet                The pointer to the received packet.
@@ -154,6 +154,9 @@ Mtftp6WrqHandleAck (
   UINT16                    AckNum;
   INTN                      Expected;
   UINT64                    TotalBlock;
+  UINT16                    BlockNum;
+  UINT16                    Index;
+  EFI_STATUS                Status;
 
   *IsCompleted = FALSE;
   AckNum       = NTOHS (Packet->Ack.Block[0]);
@@ -163,20 +166,24 @@ Mtftp6WrqHandleAck (
 
   //
   // Get an unwanted ACK, return EFI_SUCCESS to let Mtftp6WrqInput
-  // restart receive.
+  // restart receive. With a window, the server acknowledges the last
+  // block it received in order, which is between Expected and the
+  // last block sent.
   //
-  if (Expected != AckNum) {
+  if ((AckNum < Expected) || (AckNum > Instance->LastSentBlk)) {
     return EFI_SUCCESS;
   }
 
   //
-  // Remove the acked block number, if this is the last block number,
+  // Remove the acked block numbers, if this is the last block number,
   // tell the Mtftp6WrqInput to finish the transfer. This is the last
   // block number if the block range are empty..
   //
-  Mtftp6RemoveBlockNum (&Instance->BlkList, AckNum, *IsCompleted, &TotalBlock);
-
-  Expected = Mtftp6GetNextBlockNum (&Instance->BlkList);
+  do {
+    BlockNum = (UINT16) Expected;
+    Mtftp6RemoveBlockNum (&Instance->BlkList, BlockNum, *IsCompleted, &TotalBlock);
+    Expected = Mtftp6GetNextBlockNum (&Instance->BlkList);
+  } while ((BlockNum != AckNum) && (Expected >= 0));
 
   if (Expected < 0) {
     //
@@ -216,7 +223,27 @@ Mtftp6WrqHandleAck (
   NetbufFree (*UdpPacket);
   *UdpPacket = NULL;
 
-  return Mtftp6WrqSendBlock (Instance, (UINT16) Expected);
+  //
+  // Send the next window of blocks. Blocks the server didn't acknowledge
+  // are sent again. Stop after the last block, which is known once it
+  // has been read.
+  //
+  for (Index = 0; Index < Instance->WindowSize; Index++) {
+    BlockNum = (UINT16) (Expected + Index);
+    Status   = Mtftp6WrqSendBlock (Instance, BlockNum);
+
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    Instance->LastSentBlk = BlockNum;
+
+    if ((Instance->LastBlk == BlockNum) || (BlockNum == 0xffff)) {
+      break;
+    }
+  }
+
+  return EFI_SUCCESS;
 }
 
 
@@ -226,7 +253,8 @@ Mtftp6WrqHandleAck (
   1. It only include options requested by us.
   2. It can only include a smaller block size.
   3. It can't change the proposed time out value.
-  4. Other requirements of the individal MTFTP6 options as required.
+  4. It can only include a smaller window size.
+  5. Other requirements of the individal MTFTP6 options as required.
 
   @param[in]  ReplyInfo             The pointer to options information in reply packet.
   @param[in]  RequestInfo           The pointer to requested options information.
@@ -259,6 +287,11 @@ Mtftp6WrqOackValid (
     return FALSE;
   }
 
+  if (((ReplyInfo->BitMap & MTFTP6_OPT_WINDOWSIZE_BIT) != 0) &&
+      (ReplyInfo->WindowSize > RequestInfo->WindowSize)) {
+    return FALSE;
+  }
+
   return TRUE;
 }
 
@@ -353,6 +386,10 @@ Mtftp6WrqHandleOack (
     Instance->Timeout = ExtInfo.Timeout;
   }
 
+  if (ExtInfo.WindowSize != 0) {
+    Instance->WindowSize = ExtInfo.WindowSize;
+  }
+
   //
   // Build a bogus ACK0 packet then pass it to the Mtftp6WrqHandleAck,
   // which will start the transmission of the first data block.
@@ -36,6 +36,35 @@ BltLibConfigure (
   );
 
 
+/**
+  Configure a system memory copy of the frame buffer set by BltLibConfigure.
+
+  Once configured, the blt operations read the video data from the shadow
+  buffer only, and write the rectangle they modified to both the shadow
+  buffer and the frame buffer. BltLibConfigure stops using the shadow buffer,
+  so it must be configured again after each mode change.
+
+  The shadow buffer only sees the writes made through this library. When the
+  frame buffer may have been written directly, configuring the same shadow
+  buffer again reloads it from the frame buffer.
+
+  @param[in] ShadowBuffer      Pointer to the shadow buffer, or NULL to stop
+                               using a shadow buffer
+  @param[in] ShadowBufferSize  Size of the shadow buffer in bytes
+
+  @retval  EFI_INVALID_PARAMETER - The shadow buffer is too small for the mode
+  @retval  EFI_UNSUPPORTED - The BltLib does not support a shadow buffer
+  @retval  EFI_SUCCESS - The shadow buffer was configured
+
+**/
+EFI_STATUS
+EFIAPI
+BltLibConfigureShadowBuffer (
+  IN  VOID                                 *ShadowBuffer, OPTIONAL
+  IN  UINTN                                ShadowBufferSize
+  );
+
+
 /**
   Performs a UEFI Graphics Output Protocol Blt operation.
 
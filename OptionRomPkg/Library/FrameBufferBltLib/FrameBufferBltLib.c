@@ -33,6 +33,8 @@ UINTN                           mBltLibWidthInPixels;
 UINTN                           mBltLibHeight;
 UINT8                           mBltLibLineBuffer[MAX_LINE_BUFFER_SIZE];
 UINT8                           *mBltLibFrameBuffer;
+UINT8                           *mBltLibShadowBuffer;
+UINT8                           *mBltLibVideoBuffer;  // the shadow buffer if any, the frame buffer otherwise
 EFI_GRAPHICS_PIXEL_FORMAT       mPixelFormat;
 EFI_PIXEL_BITMASK               mPixelBitMasks;
 INTN                            mPixelShl[4]; // R-G-B-Rsvd
@@ -117,6 +119,8 @@ BltLibConfigure (
   mPixelFormat = FrameBufferInfo->PixelFormat;
 
   mBltLibFrameBuffer = (UINT8*) FrameBuffer;
+  mBltLibShadowBuffer = NULL;
+  mBltLibVideoBuffer = mBltLibFrameBuffer;
   mBltLibWidthInPixels = (UINTN) FrameBufferInfo->HorizontalResolution;
   mBltLibHeight = (UINTN) FrameBufferInfo->VerticalResolution;
   mBltLibWidthInBytes = mBltLibWidthInPixels * mBltLibBytesPerPixel;
@@ -127,6 +131,98 @@ BltLibConfigure (
 }
 
 
+/**
+  Configure a system memory copy of the frame buffer set by BltLibConfigure.
+
+  Reading the frame buffer is very slow on most devices, since it is uncached
+  MMIO. With a shadow buffer, the blt operations never read the frame buffer:
+  Video to BltBuffer is served from the shadow buffer, and Video to Video
+  moves the shadow buffer data and then writes the destination rectangle to
+  the frame buffer.
+
+  The shadow buffer is loaded from the frame buffer here, and afterwards only
+  follows the writes made through this library. Configuring the same shadow
+  buffer again resynchronizes it after the frame buffer was written directly.
+
+  @param[in] ShadowBuffer      Pointer to the shadow buffer, or NULL to stop
+                               using a shadow buffer
+  @param[in] ShadowBufferSize  Size of the shadow buffer in bytes
+
+  @retval  EFI_INVALID_PARAMETER - The shadow buffer is too small for the mode
+  @retval  EFI_SUCCESS - The shadow buffer was configured
+
+**/
+EFI_STATUS
+EFIAPI
+BltLibConfigureShadowBuffer (
+  IN  VOID                                 *ShadowBuffer, OPTIONAL
+  IN  UINTN                                ShadowBufferSize
+  )
+{
+  if (ShadowBuffer == NULL) {
+    mBltLibShadowBuffer = NULL;
+    mBltLibVideoBuffer = mBltLibFrameBuffer;
+    return EFI_SUCCESS;
+  }
+
+  if (ShadowBufferSize < mBltLibWidthInBytes * mBltLibHeight) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  //
+  // Read the frame buffer once, so that the shadow buffer starts with the
+  // current screen content.
+  //
+  CopyMem (ShadowBuffer, mBltLibFrameBuffer, mBltLibWidthInBytes * mBltLibHeight);
+  mBltLibShadowBuffer = (UINT8*) ShadowBuffer;
+  mBltLibVideoBuffer = mBltLibShadowBuffer;
+
+  return EFI_SUCCESS;
+}
+
+
+/**
+  Write a rectangle that was modified in the shadow buffer to the frame buffer.
+
+  Full width rectangles are contiguous, and are written with a single copy.
+
+  @param[in]  X       X location of the rectangle
+  @param[in]  Y       Y location of the rectangle
+  @param[in]  Width   Width (in pixels)
+  @param[in]  Height  Height
+
+**/
+VOID
+BltLibFlushShadowBuffer (
+  IN  UINTN                                 X,
+  IN  UINTN                                 Y,
+  IN  UINTN                                 Width,
+  IN  UINTN                                 Height
+  )
+{
+  UINTN                           Offset;
+  UINTN                           WidthInBytes;
+
+  if (mBltLibShadowBuffer == NULL) {
+    return;
+  }
+
+  Offset = mBltLibBytesPerPixel * ((Y * mBltLibWidthInPixels) + X);
+  WidthInBytes = Width * mBltLibBytesPerPixel;
+
+  if (Width == mBltLibWidthInPixels) {
+    CopyMem (mBltLibFrameBuffer + Offset, mBltLibShadowBuffer + Offset, WidthInBytes * Height);
+    return;
+  }
+
+  while (Height > 0) {
+    CopyMem (mBltLibFrameBuffer + Offset, mBltLibShadowBuffer + Offset, WidthInBytes);
+    Offset += mBltLibWidthInBytes;
+    Height--;
+  }
+}
+
+
 /**
   Performs a UEFI Graphics Output Protocol Blt operation.
 
@@ -308,7 +404,7 @@ BltLibVideoFill (
     VDEBUG ((EFI_D_INFO, "VideoFill (wide, one-shot)\n"));
     Offset = DestinationY * mBltLibWidthInPixels;
     Offset = mBltLibBytesPerPixel * Offset;
-    BltMemDst = (VOID*) (mBltLibFrameBuffer + Offset);
+    BltMemDst = (VOID*) (mBltLibVideoBuffer + Offset);
     SizeInBytes = WidthInBytes * Height;
     if (SizeInBytes >= 8) {
       SetMem32 (BltMemDst, SizeInBytes & ~3, (UINT32) WideFill);
@@ -322,7 +418,7 @@ BltLibVideoFill (
     for (DstY = DestinationY; DstY < (Height + DestinationY); DstY++) {
       Offset = (DstY * mBltLibWidthInPixels) + DestinationX;
       Offset = mBltLibBytesPerPixel * Offset;
-      BltMemDst = (VOID*) (mBltLibFrameBuffer + Offset);
+      BltMemDst = (VOID*) (mBltLibVideoBuffer + Offset);
 
       if (UseWideFill && (((UINTN) BltMemDst & 7) == 0)) {
         VDEBUG ((EFI_D_INFO, "VideoFill (wide)\n"));
@@ -353,6 +449,8 @@ BltLibVideoFill (
     }
   }
 
+  BltLibFlushShadowBuffer (DestinationX, DestinationY, Width, Height);
+
   return EFI_SUCCESS;
 }
 
@@ -468,7 +566,7 @@ BltLibVideoToBltBufferEx (
 
     Offset = (SrcY * mBltLibWidthInPixels) + SourceX;
     Offset = mBltLibBytesPerPixel * Offset;
-    BltMemSrc = (VOID *) (mBltLibFrameBuffer + Offset);
+    BltMemSrc = (VOID *) (mBltLibVideoBuffer + Offset);
 
     if (mPixelFormat == PixelBlueGreenRedReserved8BitPerColor) {
       BltMemDst =
@@ -609,7 +707,7 @@ BltLibBufferToVideoEx (
 
     Offset = (DstY * mBltLibWidthInPixels) + DestinationX;
     Offset = mBltLibBytesPerPixel * Offset;
-    BltMemDst = (VOID*) (mBltLibFrameBuffer + Offset);
+    BltMemDst = (VOID*) (mBltLibVideoBuffer + Offset);
 
     if (mPixelFormat == PixelBlueGreenRedReserved8BitPerColor) {
       BltMemSrc = (VOID *) ((UINT8 *) BltBuffer + (SrcY * Delta));
@@ -635,6 +733,8 @@ BltLibBufferToVideoEx (
     CopyMem (BltMemDst, BltMemSrc, WidthInBytes);
   }
 
+  BltLibFlushShadowBuffer (DestinationX, DestinationY, Width, Height);
+
   return EFI_SUCCESS;
 }
 
@@ -670,6 +770,7 @@ BltLibVideoToVideo (
   UINTN                           Offset;
   UINTN                           WidthInBytes;
   INTN                            LineStride;
+  UINTN                           LinesToCopy;
 
   //
   // Video to Video: Source is Video, destination is Video
@@ -698,25 +799,35 @@ BltLibVideoToVideo (
 
   Offset = (SourceY * mBltLibWidthInPixels) + SourceX;
   Offset = mBltLibBytesPerPixel * Offset;
-  BltMemSrc = (VOID *) (mBltLibFrameBuffer + Offset);
+  BltMemSrc = (VOID *) (mBltLibVideoBuffer + Offset);
 
   Offset = (DestinationY * mBltLibWidthInPixels) + DestinationX;
   Offset = mBltLibBytesPerPixel * Offset;
-  BltMemDst = (VOID *) (mBltLibFrameBuffer + Offset);
+  BltMemDst = (VOID *) (mBltLibVideoBuffer + Offset);
 
+  //
+  // When the destination is below the source, copy from the bottom line up
+  // so that the overlapping source lines are not overwritten before they are
+  // read.
+  //
   LineStride = mBltLibWidthInBytes;
   if ((UINTN) BltMemDst > (UINTN) BltMemSrc) {
     LineStride = -LineStride;
+    BltMemSrc = (VOID*) ((UINT8*) BltMemSrc + (Height - 1) * mBltLibWidthInBytes);
+    BltMemDst = (VOID*) ((UINT8*) BltMemDst + (Height - 1) * mBltLibWidthInBytes);
   }
 
-  while (Height > 0) {
+  LinesToCopy = Height;
+  while (LinesToCopy > 0) {
     CopyMem (BltMemDst, BltMemSrc, WidthInBytes);
 
     BltMemSrc = (VOID*) ((UINT8*) BltMemSrc + LineStride);
     BltMemDst = (VOID*) ((UINT8*) BltMemDst + LineStride);
-    Height--;
+    LinesToCopy--;
   }
 
+  BltLibFlushShadowBuffer (DestinationX, DestinationY, Width, Height);
+
   return EFI_SUCCESS;
 }
 
@@ -79,6 +79,29 @@ BltLibConfigure (
 }
 
 
+/**
+  Configure a system memory copy of the frame buffer set by BltLibConfigure.
+
+  The GOP instance owns its frame buffer, so a shadow buffer is not supported.
+
+  @param[in] ShadowBuffer      Pointer to the shadow buffer, or NULL to stop
+                               using a shadow buffer
+  @param[in] ShadowBufferSize  Size of the shadow buffer in bytes
+
+  @retval  EFI_UNSUPPORTED - The BltLib does not support a shadow buffer
+
+**/
+EFI_STATUS
+EFIAPI
+BltLibConfigureShadowBuffer (
+  IN  VOID                                 *ShadowBuffer, OPTIONAL
+  IN  UINTN                                ShadowBufferSize
+  )
+{
+  return EFI_UNSUPPORTED;
+}
+
+
 /**
   Performs a UEFI Graphics Output Protocol Blt operation.
 
@@ -23,6 +23,12 @@
 
 #include <Library/VirtioLib.h>
 
+//
+// Number of CpuPause() iterations VirtioFlush() spins on the used ring before
+// it falls back to polling with gBS->Stall().
+//
+#define VIRTIO_FLUSH_SPIN_COUNT 0x4000
+
 
 /**
 
@@ -267,6 +273,7 @@ VirtioFlush (
   UINT16     NextAvailIdx;
   EFI_STATUS Status;
   UINTN      PollPeriodUsecs;
+  UINTN      SpinCount;
 
   //
   // virtio-0.9.5, 2.4.1.2 Updating the Available Ring
@@ -287,12 +294,16 @@ VirtioFlush (
 
   //
   // virtio-0.9.5, 2.4.1.4 Notifying the Device -- gratuitous notifications are
-  // OK.
+  // OK. The notification is a VM exit, so skip it when the host has set
+  // VRING_USED_F_NO_NOTIFY; it is then processing the queue and will see the
+  // new available index without being notified.
   //
   MemoryFence();
-  Status = VirtIo->SetQueueNotify (VirtIo, VirtQueueId);
-  if (EFI_ERROR (Status)) {
-    return Status;
+  if ((*Ring->Used.Flags & VRING_USED_F_NO_NOTIFY) == 0) {
+    Status = VirtIo->SetQueueNotify (VirtIo, VirtQueueId);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
   }
 
   //
@@ -300,6 +311,21 @@ VirtioFlush (
   // Wait until the host processes and acknowledges our descriptor chain. The
   // condition we use for polling is greatly simplified and relies on the
   // synchronous, lock-step progress.
+  //
+  // Most requests complete within a few microseconds, so spin on the used
+  // index first. Each gBS->Stall() reads the ACPI PM timer, and every such
+  // read is a VM exit that competes with the host processing our request.
+  //
+  MemoryFence();
+  for (SpinCount = 0; SpinCount < VIRTIO_FLUSH_SPIN_COUNT; ++SpinCount) {
+    if (*Ring->Used.Idx == NextAvailIdx) {
+      MemoryFence();
+      return EFI_SUCCESS;
+    }
+    CpuPause ();
+    MemoryFence();
+  }
+
   //
   // Keep slowing down until we reach a poll period of slightly above 1 ms.
   //
@@ -201,11 +201,39 @@ Routine Description:
 
   QemuVideoCompleteModeData (Private, This->Mode);
 
+  if (Private->ShadowBuffer != NULL) {
+    FreePages (Private->ShadowBuffer, Private->ShadowBufferPages);
+    Private->ShadowBuffer = NULL;
+  }
+
   BltLibConfigure (
     (VOID*)(UINTN) This->Mode->FrameBufferBase,
     This->Mode->Info
     );
 
+  //
+  // Keep a copy of the frame buffer in system memory, so that the Blt
+  // operations, and the console scrolling in particular, never read from
+  // video memory. Without it the Blt operations still work, only slower.
+  //
+  // The copy assumes that only Blt() writes to the frame buffer. The frame
+  // buffer is still published in Mode->FrameBufferBase, and a client writing
+  // it directly leaves the copy stale: EfiBltVideoToBltBuffer and
+  // EfiBltVideoToVideo then return the old pixels until SetMode() is called,
+  // which reloads the copy from the frame buffer.
+  //
+  Private->ShadowBufferPages = EFI_SIZE_TO_PAGES (This->Mode->FrameBufferSize);
+  Private->ShadowBuffer      = AllocatePages (Private->ShadowBufferPages);
+  if (Private->ShadowBuffer != NULL) {
+    if (EFI_ERROR (BltLibConfigureShadowBuffer (
+                     Private->ShadowBuffer,
+                     EFI_PAGES_TO_SIZE (Private->ShadowBufferPages)
+                     ))) {
+      FreePages (Private->ShadowBuffer, Private->ShadowBufferPages);
+      Private->ShadowBuffer = NULL;
+    }
+  }
+
   return EFI_SUCCESS;
 }
 
@@ -327,6 +355,7 @@ QemuVideoGraphicsOutputConstructor (
   Private->GraphicsOutput.Mode->MaxMode = (UINT32) Private->MaxMode;
   Private->GraphicsOutput.Mode->Mode    = GRAPHICS_OUTPUT_INVALIDE_MODE_NUMBER;
   Private->LineBuffer                   = NULL;
+  Private->ShadowBuffer                 = NULL;
 
   //
   // Initialize the hardware
@@ -374,6 +403,12 @@ Returns:
     FreePool (Private->LineBuffer);
   }
 
+  if (Private->ShadowBuffer != NULL) {
+    BltLibConfigureShadowBuffer (NULL, 0);
+    FreePages (Private->ShadowBuffer, Private->ShadowBufferPages);
+    Private->ShadowBuffer = NULL;
+  }
+
   if (Private->GraphicsOutput.Mode != NULL) {
     if (Private->GraphicsOutput.Mode->Info != NULL) {
       gBS->FreePool (Private->GraphicsOutput.Mode->Info);
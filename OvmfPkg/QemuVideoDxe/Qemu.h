@@ -118,6 +118,8 @@ typedef struct {
   QEMU_VIDEO_MODE_DATA                  *ModeData;
 
   UINT8                                 *LineBuffer;
+  VOID                                  *ShadowBuffer;
+  UINTN                                 ShadowBufferPages;
   QEMU_VIDEO_VARIANT                    Variant;
 } QEMU_VIDEO_PRIVATE_DATA;
 
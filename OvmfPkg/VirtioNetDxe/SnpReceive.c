@@ -176,8 +176,7 @@ RecycleDesc:
   MemoryFence ();
   *Dev->RxRing.Avail.Idx = AvailIdx;
 
-  MemoryFence ();
-  NotifyStatus = Dev->VirtIo->SetQueueNotify (Dev->VirtIo, VIRTIO_NET_Q_RX);
+  NotifyStatus = VirtioNetNotifyQueue (Dev, &Dev->RxRing, VIRTIO_NET_Q_RX);
   if (!EFI_ERROR (Status)) { // earlier error takes precedence
     Status = NotifyStatus;
   }
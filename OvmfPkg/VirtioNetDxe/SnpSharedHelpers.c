@@ -14,6 +14,7 @@
 
 **/
 
+#include <Library/BaseLib.h>
 #include <Library/MemoryAllocationLib.h>
 
 #include "VirtioNet.h"
@@ -51,3 +52,44 @@ VirtioNetShutdownTx (
 {
   FreePool (Dev->TxFreeStack);
 }
+
+
+/**
+  Notify the host about new buffers on one of the queues, unless the host
+  asked to be left alone.
+
+  Each notification is a VM exit. The host sets VRING_USED_F_NO_NOTIFY in the
+  used ring while it is busy with the queue anyway (virtio-0.9.5, 2.4.1.4
+  Notifying The Device), for example while it has enough receive buffers, or
+  while it is processing transmit requests. The caller must have published
+  the new available index before calling this function.
+
+  This function is only callable by the VirtioNetTransmit() and the
+  VirtioNetReceive() SNP methods.
+
+  @param[in] Dev         The VNET_DEV driver instance.
+  @param[in] Ring        The ring whose available index has been advanced.
+  @param[in] QueueIndex  VIRTIO_NET_Q_RX or VIRTIO_NET_Q_TX, matching Ring.
+
+  @retval EFI_SUCCESS  The host has been notified, or it didn't want a
+                       notification.
+  @return              Error codes from VIRTIO_DEVICE_PROTOCOL.SetQueueNotify.
+*/
+
+EFI_STATUS
+EFIAPI
+VirtioNetNotifyQueue (
+  IN VNET_DEV *Dev,
+  IN VRING    *Ring,
+  IN UINT16   QueueIndex
+  )
+{
+  //
+  // order the available index update before reading the flags
+  //
+  MemoryFence ();
+  if ((*Ring->Used.Flags & VRING_USED_F_NO_NOTIFY) != 0) {
+    return EFI_SUCCESS;
+  }
+  return Dev->VirtIo->SetQueueNotify (Dev->VirtIo, QueueIndex);
+}
@@ -263,6 +263,14 @@ VirtioNetShutdownTx (
   IN OUT VNET_DEV *Dev
   );
 
+EFI_STATUS
+EFIAPI
+VirtioNetNotifyQueue (
+  IN VNET_DEV *Dev,
+  IN VRING    *Ring,
+  IN UINT16   QueueIndex
+  );
+
 //
 // event callbacks
 //